@@ -66,6 +66,10 @@
 #define HYBRIDCLR_ENABLE_STRACKTRACE IL2CPP_ENABLE_STACKTRACE_SENTRIES
 #endif
 
+#ifndef HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+#define HYBRIDCLR_ENABLE_SAMPLING_PROFILER 0
+#endif
+
 #if UNITY_ENGINE_TUANJIE
 #define HYBRIDCLR_MALLOC(size) IL2CPP_MALLOC(size, IL2CPP_MEM_META_POOL)
 #define HYBRIDCLR_MALLOC_ALIGNED(size, alignment) IL2CPP_MALLOC_ALIGNED(size, alignment, IL2CPP_MEM_META_POOL)
@@ -0,0 +1,143 @@
+#include "MemoryStats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+#include "os/Mutex.h"
+
+namespace hybridclr
+{
+	constexpr int32_t kMemoryCategoryCount = (int32_t)MemoryCategory::Count;
+
+	struct ImageMemoryStats
+	{
+		MemoryCategoryStats categories[kMemoryCategoryCount];
+	};
+
+	static std::atomic<int64_t> s_liveBytes[kMemoryCategoryCount];
+	static std::atomic<int64_t> s_liveCounts[kMemoryCategoryCount];
+
+	static il2cpp::os::FastMutex s_imageStatsLock;
+	static std::unordered_map<const Il2CppImage*, ImageMemoryStats> s_imageStats;
+
+	static void UpdateStats(MemoryCategory category, int64_t size, int64_t count, const Il2CppImage* image)
+	{
+		int32_t index = (int32_t)category;
+		IL2CPP_ASSERT(index >= 0 && index < kMemoryCategoryCount);
+		s_liveBytes[index].fetch_add(size, std::memory_order_relaxed);
+		s_liveCounts[index].fetch_add(count, std::memory_order_relaxed);
+		if (image)
+		{
+			il2cpp::os::FastAutoLock lock(&s_imageStatsLock);
+			MemoryCategoryStats& stats = s_imageStats[image].categories[index];
+			stats.liveBytes += size;
+			stats.liveCount += count;
+		}
+	}
+
+	void MemoryStats::OnAllocate(MemoryCategory category, size_t size, const Il2CppImage* image)
+	{
+		UpdateStats(category, (int64_t)size, 1, image);
+	}
+
+	void MemoryStats::OnFree(MemoryCategory category, size_t size, const Il2CppImage* image)
+	{
+		UpdateStats(category, -(int64_t)size, -1, image);
+	}
+
+	MemoryCategoryStats MemoryStats::GetCategoryStats(MemoryCategory category)
+	{
+		int32_t index = (int32_t)category;
+		IL2CPP_ASSERT(index >= 0 && index < kMemoryCategoryCount);
+		return { s_liveBytes[index].load(std::memory_order_relaxed), s_liveCounts[index].load(std::memory_order_relaxed) };
+	}
+
+	MemoryCategoryStats MemoryStats::GetImageCategoryStats(const Il2CppImage* image, MemoryCategory category)
+	{
+		int32_t index = (int32_t)category;
+		IL2CPP_ASSERT(index >= 0 && index < kMemoryCategoryCount);
+		il2cpp::os::FastAutoLock lock(&s_imageStatsLock);
+		auto it = s_imageStats.find(image);
+		return it != s_imageStats.end() ? it->second.categories[index] : MemoryCategoryStats{ 0, 0 };
+	}
+
+	const char* MemoryStats::GetCategoryName(MemoryCategory category)
+	{
+		switch (category)
+		{
+		case MemoryCategory::InterpMethodInfo: return "InterpMethodInfo";
+		case MemoryCategory::MethodBody: return "MethodBody";
+		case MemoryCategory::MachineState: return "MachineState";
+		case MemoryCategory::ImageData: return "ImageData";
+		case MemoryCategory::DebugInfo: return "DebugInfo";
+		case MemoryCategory::CustomAttributeData: return "CustomAttributeData";
+		case MemoryCategory::TransformArena: return "TransformArena";
+		default: return "Unknown";
+		}
+	}
+
+	static void AppendStatsTable(std::string& report, const MemoryCategoryStats* categories)
+	{
+		char line[128];
+		int64_t totalBytes = 0;
+		int64_t totalCount = 0;
+		for (int32_t i = 0; i < kMemoryCategoryCount; i++)
+		{
+			const MemoryCategoryStats& stats = categories[i];
+			std::snprintf(line, sizeof(line), "  %-20s %16lld %12lld\n", MemoryStats::GetCategoryName((MemoryCategory)i), (long long)stats.liveBytes, (long long)stats.liveCount);
+			report.append(line);
+			totalBytes += stats.liveBytes;
+			totalCount += stats.liveCount;
+		}
+		std::snprintf(line, sizeof(line), "  %-20s %16lld %12lld\n", "Total", (long long)totalBytes, (long long)totalCount);
+		report.append(line);
+	}
+
+	static int64_t GetTotalLiveBytes(const ImageMemoryStats& stats)
+	{
+		int64_t totalBytes = 0;
+		for (int32_t i = 0; i < kMemoryCategoryCount; i++)
+		{
+			totalBytes += stats.categories[i].liveBytes;
+		}
+		return totalBytes;
+	}
+
+	std::string MemoryStats::GetReport()
+	{
+		MemoryCategoryStats totals[kMemoryCategoryCount];
+		for (int32_t i = 0; i < kMemoryCategoryCount; i++)
+		{
+			totals[i] = GetCategoryStats((MemoryCategory)i);
+		}
+
+		std::vector<std::pair<const Il2CppImage*, ImageMemoryStats>> images;
+		{
+			il2cpp::os::FastAutoLock lock(&s_imageStatsLock);
+			images.assign(s_imageStats.begin(), s_imageStats.end());
+		}
+		std::sort(images.begin(), images.end(), [](const std::pair<const Il2CppImage*, ImageMemoryStats>& a, const std::pair<const Il2CppImage*, ImageMemoryStats>& b)
+			{
+				return GetTotalLiveBytes(a.second) > GetTotalLiveBytes(b.second);
+			});
+
+		char line[256];
+		std::string report;
+		std::snprintf(line, sizeof(line), "  %-20s %16s %12s\n", "category", "live bytes", "live count");
+		report.append(line);
+		report.append("[all]\n");
+		AppendStatsTable(report, totals);
+		for (auto& e : images)
+		{
+			const Il2CppImage* image = e.first;
+			const char* assemblyName = image->assembly ? image->assembly->aname.name : "";
+			std::snprintf(line, sizeof(line), "[image] %s assembly:%s\n", image->name, assemblyName);
+			report.append(line);
+			AppendStatsTable(report, e.second.categories);
+		}
+		return report;
+	}
+}
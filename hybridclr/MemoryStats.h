@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+
+#include "CommonDef.h"
+
+namespace hybridclr
+{
+	enum class MemoryCategory
+	{
+		InterpMethodInfo = 0,
+		MethodBody = 1,
+		MachineState = 2,
+		ImageData = 3,
+		DebugInfo = 4,
+		CustomAttributeData = 5,
+		TransformArena = 6,
+		Count,
+	};
+
+	struct MemoryCategoryStats
+	{
+		int64_t liveBytes;
+		int64_t liveCount;
+	};
+
+	// live bytes and allocation counts of the major HybridCLR-owned allocations, per category and per image.
+	// allocations that aren't bound to an image (interpreter thread stacks, transform arenas) only appear in the totals.
+	// metadata memory is never freed, so its categories only grow.
+	class MemoryStats
+	{
+	public:
+		static void OnAllocate(MemoryCategory category, size_t size, const Il2CppImage* image = nullptr);
+		static void OnFree(MemoryCategory category, size_t size, const Il2CppImage* image = nullptr);
+
+		static MemoryCategoryStats GetCategoryStats(MemoryCategory category);
+		static MemoryCategoryStats GetImageCategoryStats(const Il2CppImage* image, MemoryCategory category);
+
+		static const char* GetCategoryName(MemoryCategory category);
+
+		// a text table of the totals followed by one table per image, one line per category.
+		static std::string GetReport();
+	};
+}
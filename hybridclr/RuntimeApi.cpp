@@ -1,25 +1,51 @@
 #include "RuntimeApi.h"
 
+#include <cstring>
+#include <vector>
+
 #include "codegen/il2cpp-codegen.h"
 #include "vm/InternalCalls.h"
 #include "vm/Array.h"
 #include "vm/Exception.h"
 #include "vm/Class.h"
+#include "vm/String.h"
+#include "vm/Reflection.h"
+#include "vm/MetadataLock.h"
 
 #include "metadata/MetadataModule.h"
+#include "metadata/InterpreterImage.h"
+#include "metadata/MetadataPool.h"
 #include "metadata/MetadataUtil.h"
 #include "interpreter/InterpreterModule.h"
+#include "interpreter/SamplingProfiler.h"
+#include "interpreter/MethodBodyHotReloader.h"
+#include "transform/SharedInterpMethodInfoPool.h"
 #include "RuntimeConfig.h"
+#include "MemoryStats.h"
 
 namespace hybridclr
 {
 	void RuntimeApi::RegisterInternalCalls()
 	{
 		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::LoadMetadataForAOTAssembly(System.Byte[],HybridCLR.HomologousImageMode)", (Il2CppMethodPointer)LoadMetadataForAOTAssembly);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::ReloadMethodBodies(System.Reflection.Assembly,System.Byte[],System.Byte[])", (Il2CppMethodPointer)ReloadMethodBodies);
 		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetRuntimeOption(HybridCLR.RuntimeOptionId)", (Il2CppMethodPointer)GetRuntimeOption);
 		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::SetRuntimeOption(HybridCLR.RuntimeOptionId,System.Int32)", (Il2CppMethodPointer)SetRuntimeOption);
 		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::PreJitClass(System.Type)", (Il2CppMethodPointer)PreJitClass);
 		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::PreJitMethod(System.Reflection.MethodInfo)", (Il2CppMethodPointer)PreJitMethod);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetInitLocalsSkippedSize(System.Reflection.MethodInfo)", (Il2CppMethodPointer)GetInitLocalsSkippedSize);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::RetransformDependentMethods(System.Reflection.MethodBase)", (Il2CppMethodPointer)RetransformDependentMethods);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetPooledIl2CppTypeSavedBytes()", (Il2CppMethodPointer)GetPooledIl2CppTypeSavedBytes);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetSharedInterpMethodBodySavedBytes()", (Il2CppMethodPointer)GetSharedInterpMethodBodySavedBytes);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetMemoryLiveBytes(HybridCLR.MemoryCategory)", (Il2CppMethodPointer)GetMemoryLiveBytes);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetMemoryLiveCount(HybridCLR.MemoryCategory)", (Il2CppMethodPointer)GetMemoryLiveCount);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetMemoryReport()", (Il2CppMethodPointer)GetMemoryReport);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetTypesWithCustomAttribute(System.Reflection.Assembly,System.Type)", (Il2CppMethodPointer)GetTypesWithCustomAttribute);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetMethodsWithCustomAttribute(System.Reflection.Assembly,System.Type)", (Il2CppMethodPointer)GetMethodsWithCustomAttribute);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::StartSamplingProfiler(System.Int32)", (Il2CppMethodPointer)StartSamplingProfiler);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::StopSamplingProfiler()", (Il2CppMethodPointer)StopSamplingProfiler);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::ResetSamplingProfiler()", (Il2CppMethodPointer)ResetSamplingProfiler);
+		il2cpp::vm::InternalCalls::Add("HybridCLR.RuntimeApi::GetSamplingProfilerFoldedStacks(System.Boolean)", (Il2CppMethodPointer)GetSamplingProfilerFoldedStacks);
 	}
 
 	int32_t RuntimeApi::LoadMetadataForAOTAssembly(Il2CppArray* dllBytes, int32_t mode)
@@ -31,6 +57,17 @@ namespace hybridclr
 		return (int32_t)hybridclr::metadata::Assembly::LoadMetadataForAOTAssembly(il2cpp::vm::Array::GetFirstElementAddress(dllBytes), il2cpp::vm::Array::GetByteLength(dllBytes), (hybridclr::metadata::HomologousImageMode)mode);
 	}
 
+	int32_t RuntimeApi::ReloadMethodBodies(Il2CppReflectionAssembly* assembly, Il2CppArray* dllBytes, Il2CppArray* pdbBytes)
+	{
+		if (!assembly || !dllBytes)
+		{
+			il2cpp::vm::Exception::RaiseNullReferenceException();
+		}
+		return (int32_t)interpreter::MethodBodyHotReloader::ReloadMethodBodies(assembly->assembly,
+			il2cpp::vm::Array::GetFirstElementAddress(dllBytes), il2cpp::vm::Array::GetByteLength(dllBytes),
+			pdbBytes ? il2cpp::vm::Array::GetFirstElementAddress(pdbBytes) : nullptr, pdbBytes ? il2cpp::vm::Array::GetByteLength(pdbBytes) : 0);
+	}
+
 	int32_t RuntimeApi::GetRuntimeOption(int32_t optionId)
 	{
 		return hybridclr::RuntimeConfig::GetRuntimeOption((hybridclr::RuntimeOptionId)optionId);
@@ -105,4 +142,149 @@ namespace hybridclr
 	{
 		return PreJitMethod0(method->method);
 	}
+
+	int32_t RuntimeApi::GetInitLocalsSkippedSize(Il2CppReflectionMethod* method)
+	{
+		if (!PreJitMethod0(method->method))
+		{
+			return -1;
+		}
+		const interpreter::InterpMethodInfo* imi = interpreter::InterpreterModule::GetOrTransformInterpMethodInfo(method->method);
+		return (int32_t)imi->initLocalsSkippedSize;
+	}
+
+	int32_t RuntimeApi::RetransformDependentMethods(Il2CppReflectionMethod* method)
+	{
+		if (!method)
+		{
+			il2cpp::vm::Exception::RaiseNullReferenceException();
+		}
+		return interpreter::InterpreterModule::RetransformDependentMethods(method->method);
+	}
+
+	int64_t RuntimeApi::GetPooledIl2CppTypeSavedBytes()
+	{
+		uint64_t pooledTypeCount;
+		uint64_t reusedTypeCount;
+		metadata::MetadataPool::GetPooledIl2CppTypeStats(pooledTypeCount, reusedTypeCount);
+		return (int64_t)(reusedTypeCount * sizeof(Il2CppType));
+	}
+
+	int64_t RuntimeApi::GetSharedInterpMethodBodySavedBytes()
+	{
+		il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
+		uint64_t sharedMethodCount;
+		uint64_t savedBytes;
+		transform::SharedInterpMethodInfoPool::GetStats(sharedMethodCount, savedBytes);
+		return (int64_t)savedBytes;
+	}
+
+	static MemoryCategory CheckMemoryCategory(int32_t category)
+	{
+		if (category < 0 || category >= (int32_t)MemoryCategory::Count)
+		{
+			il2cpp::vm::Exception::Raise(il2cpp::vm::Exception::GetArgumentOutOfRangeException("category"));
+		}
+		return (MemoryCategory)category;
+	}
+
+	int64_t RuntimeApi::GetMemoryLiveBytes(int32_t category)
+	{
+		return MemoryStats::GetCategoryStats(CheckMemoryCategory(category)).liveBytes;
+	}
+
+	int64_t RuntimeApi::GetMemoryLiveCount(int32_t category)
+	{
+		return MemoryStats::GetCategoryStats(CheckMemoryCategory(category)).liveCount;
+	}
+
+	Il2CppString* RuntimeApi::GetMemoryReport()
+	{
+		std::string report = MemoryStats::GetReport();
+		return il2cpp::vm::String::NewLen(report.c_str(), (uint32_t)report.length());
+	}
+
+	static void GetCustomAttributeParentTokens(Il2CppReflectionAssembly* assembly, Il2CppReflectionType* attributeType, metadata::TableType parentType, std::vector<uint32_t>& rowIndexes)
+	{
+		if (!assembly || !attributeType)
+		{
+			il2cpp::vm::Exception::RaiseNullReferenceException();
+		}
+		const Il2CppImage* image = assembly->assembly->image;
+		if (!metadata::IsInterpreterImage(image))
+		{
+			return;
+		}
+		Il2CppClass* attributeKlass = il2cpp::vm::Class::FromIl2CppType(attributeType->type);
+		std::vector<uint32_t> parentTokens;
+		metadata::MetadataModule::GetImage(image)->GetCustomAttributeParentTokens(attributeKlass, parentTokens);
+		for (uint32_t token : parentTokens)
+		{
+			if (metadata::DecodeTokenTableType(token) == parentType)
+			{
+				rowIndexes.push_back(metadata::DecodeTokenRowIndex(token));
+			}
+		}
+	}
+
+	Il2CppArray* RuntimeApi::GetTypesWithCustomAttribute(Il2CppReflectionAssembly* assembly, Il2CppReflectionType* attributeType)
+	{
+		std::vector<uint32_t> rowIndexes;
+		GetCustomAttributeParentTokens(assembly, attributeType, metadata::TableType::TYPEDEF, rowIndexes);
+		metadata::InterpreterImage* image = rowIndexes.empty() ? nullptr : metadata::MetadataModule::GetImage(assembly->assembly->image);
+		Il2CppArray* types = il2cpp::vm::Array::New(il2cpp_defaults.systemtype_class, (il2cpp_array_size_t)rowIndexes.size());
+		for (size_t i = 0; i < rowIndexes.size(); i++)
+		{
+			Il2CppClass* klass = image->GetTypeInfoFromTypeDefinitionRawIndex(rowIndexes[i] - 1);
+			il2cpp_array_setref(types, i, il2cpp::vm::Reflection::GetTypeObject(&klass->byval_arg));
+		}
+		return types;
+	}
+
+	Il2CppArray* RuntimeApi::GetMethodsWithCustomAttribute(Il2CppReflectionAssembly* assembly, Il2CppReflectionType* attributeType)
+	{
+		std::vector<uint32_t> rowIndexes;
+		GetCustomAttributeParentTokens(assembly, attributeType, metadata::TableType::METHOD, rowIndexes);
+		metadata::InterpreterImage* image = rowIndexes.empty() ? nullptr : metadata::MetadataModule::GetImage(assembly->assembly->image);
+		// constructors are ConstructorInfo and can't be stored in a MethodInfo[]
+		std::vector<const MethodInfo*> methods;
+		for (uint32_t rowIndex : rowIndexes)
+		{
+			const MethodInfo* method = image->GetMethodInfoFromMethodDefinitionRawIndex(rowIndex - 1);
+			if (std::strcmp(method->name, ".ctor") && std::strcmp(method->name, ".cctor"))
+			{
+				methods.push_back(method);
+			}
+		}
+		Il2CppArray* methodObjs = il2cpp::vm::Array::New(il2cpp_defaults.method_info_class, (il2cpp_array_size_t)methods.size());
+		for (size_t i = 0; i < methods.size(); i++)
+		{
+			il2cpp_array_setref(methodObjs, i, il2cpp::vm::Reflection::GetMethodObject(methods[i], nullptr));
+		}
+		return methodObjs;
+	}
+	int32_t RuntimeApi::StartSamplingProfiler(int32_t intervalMicroseconds)
+	{
+		if (intervalMicroseconds <= 0)
+		{
+			il2cpp::vm::Exception::Raise(il2cpp::vm::Exception::GetArgumentOutOfRangeException("intervalMicroseconds"));
+		}
+		return interpreter::SamplingProfiler::Start((uint32_t)intervalMicroseconds);
+	}
+
+	void RuntimeApi::StopSamplingProfiler()
+	{
+		interpreter::SamplingProfiler::Stop();
+	}
+
+	void RuntimeApi::ResetSamplingProfiler()
+	{
+		interpreter::SamplingProfiler::Reset();
+	}
+
+	Il2CppString* RuntimeApi::GetSamplingProfilerFoldedStacks(bool includeLineNumbers)
+	{
+		std::string foldedStacks = interpreter::SamplingProfiler::GetFoldedStacks(includeLineNumbers);
+		return il2cpp::vm::String::NewLen(foldedStacks.c_str(), (uint32_t)foldedStacks.length());
+	}
 }
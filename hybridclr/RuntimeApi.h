@@ -11,11 +11,29 @@ namespace hybridclr
 		static void RegisterInternalCalls();
 
 		static int32_t LoadMetadataForAOTAssembly(Il2CppArray* dllData, int32_t mode);
+		static int32_t ReloadMethodBodies(Il2CppReflectionAssembly* assembly, Il2CppArray* dllBytes, Il2CppArray* pdbBytes);
 
 		static int32_t GetRuntimeOption(int32_t optionId);
 		static void SetRuntimeOption(int32_t optionId, int32_t value);
 
 		static int32_t PreJitClass(Il2CppReflectionType* type);
 		static int32_t PreJitMethod(Il2CppReflectionMethod* method);
+		static int32_t GetInitLocalsSkippedSize(Il2CppReflectionMethod* method);
+		static int32_t RetransformDependentMethods(Il2CppReflectionMethod* method);
+
+		static int64_t GetPooledIl2CppTypeSavedBytes();
+		static int64_t GetSharedInterpMethodBodySavedBytes();
+
+		static int64_t GetMemoryLiveBytes(int32_t category);
+		static int64_t GetMemoryLiveCount(int32_t category);
+		static Il2CppString* GetMemoryReport();
+
+		static Il2CppArray* GetTypesWithCustomAttribute(Il2CppReflectionAssembly* assembly, Il2CppReflectionType* attributeType);
+		static Il2CppArray* GetMethodsWithCustomAttribute(Il2CppReflectionAssembly* assembly, Il2CppReflectionType* attributeType);
+
+		static int32_t StartSamplingProfiler(int32_t intervalMicroseconds);
+		static void StopSamplingProfiler();
+		static void ResetSamplingProfiler();
+		static Il2CppString* GetSamplingProfilerFoldedStacks(bool includeLineNumbers);
 	};
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ namespace hybridclr
 	static int32_t s_maxMethodBodyCacheSize = 1024;
 	static int32_t s_maxMethodInlineDepth = 3;
 	static int32_t s_maxInlineableMethodBodySize = 32;
+	static int32_t s_maxMetadataInitWorkerCount = 1;
 
 
 
@@ -29,6 +30,8 @@ namespace hybridclr
 			return s_maxMethodInlineDepth;
 		case RuntimeOptionId::MaxInlineableMethodBodySize:
 			return s_maxInlineableMethodBodySize;
+		case RuntimeOptionId::MaxMetadataInitWorkerCount:
+			return s_maxMetadataInitWorkerCount;
 		default:
 		{
 			TEMP_FORMAT(optionIdStr, "%d", optionId);
@@ -60,6 +63,9 @@ namespace hybridclr
 		case RuntimeOptionId::MaxInlineableMethodBodySize:
 			s_maxInlineableMethodBodySize = value;
 			break;
+		case RuntimeOptionId::MaxMetadataInitWorkerCount:
+			s_maxMetadataInitWorkerCount = value;
+			break;
 		default:
 		{
 			TEMP_FORMAT(optionIdStr, "%d", optionId);
@@ -99,4 +105,9 @@ namespace hybridclr
 		return s_maxInlineableMethodBodySize;
 	}
 
+	int32_t RuntimeConfig::GetMaxMetadataInitWorkerCount()
+	{
+		return s_maxMetadataInitWorkerCount;
+	}
+
 }
@@ -12,6 +12,7 @@ namespace hybridclr
 		MaxMethodBodyCacheSize = 4,
 		MaxMethodInlineDepth = 5,
 		MaxInlineableMethodBodySize = 6,
+		MaxMetadataInitWorkerCount = 7,
 	};
 
 	class RuntimeConfig
@@ -28,6 +29,7 @@ namespace hybridclr
 		static int32_t GetMaxMethodBodyCacheSize();
 		static int32_t GetMaxMethodInlineDepth();
 		static int32_t GetMaxInlineableMethodBodySize();
+		static int32_t GetMaxMetadataInitWorkerCount();
 	};
 }
 
@@ -26,31 +26,41 @@ namespace interpreter
 #define POP_STACK_FRAME() 
 #endif
 
-	InterpFrame* InterpFrameGroup::EnterFrameFromInterpreter(const MethodInfo* method, StackObject* argBase)
+#if HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+#define BEGIN_FRAME_UPDATE() _machineState.BeginFrameUpdate()
+#define END_FRAME_UPDATE() _machineState.EndFrameUpdate()
+#else
+#define BEGIN_FRAME_UPDATE()
+#define END_FRAME_UPDATE()
+#endif
+
+	InterpFrame* InterpFrameGroup::EnterFrameFromInterpreter(const MethodInfo* method, const InterpMethodInfo* imi, StackObject* argBase)
 	{
 #if HYBRIDCLR_ENABLE_PROFILER
 		il2cpp_codegen_profiler_method_enter(method);
 #endif
-		const InterpMethodInfo* imi = (const InterpMethodInfo*)method->interpData;
 		int32_t oldStackTop = _machineState.GetStackTop();
 		StackObject* stackBasePtr = _machineState.AllocStackSlot(imi->maxStackSize - imi->argStackObjectSize);
+		BEGIN_FRAME_UPDATE();
 		InterpFrame* newFrame = _machineState.PushFrame();
-		*newFrame = { method, argBase, oldStackTop, nullptr, nullptr, nullptr, 0, 0, _machineState.GetLocalPoolBottomIdx() };
+		*newFrame = { method, imi, argBase, oldStackTop, nullptr, nullptr, nullptr, 0, 0, _machineState.GetLocalPoolBottomIdx() };
+		END_FRAME_UPDATE();
 		PUSH_STACK_FRAME(method, (uintptr_t)newFrame);
 		return newFrame;
 	}
 
 
-	InterpFrame* InterpFrameGroup::EnterFrameFromNative(const MethodInfo* method, StackObject* argBase)
+	InterpFrame* InterpFrameGroup::EnterFrameFromNative(const MethodInfo* method, const InterpMethodInfo* imi, StackObject* argBase)
 	{
 #if HYBRIDCLR_ENABLE_PROFILER
 		il2cpp_codegen_profiler_method_enter(method);
 #endif
-		const InterpMethodInfo* imi = (const InterpMethodInfo*)method->interpData;
 		int32_t oldStackTop = _machineState.GetStackTop();
 		StackObject* stackBasePtr = _machineState.AllocStackSlot(imi->maxStackSize);
+		BEGIN_FRAME_UPDATE();
 		InterpFrame* newFrame = _machineState.PushFrame();
-		*newFrame = { method, stackBasePtr, oldStackTop, nullptr, nullptr, nullptr, 0, 0, _machineState.GetLocalPoolBottomIdx() };
+		*newFrame = { method, imi, stackBasePtr, oldStackTop, nullptr, nullptr, nullptr, 0, 0, _machineState.GetLocalPoolBottomIdx() };
+		END_FRAME_UPDATE();
 
 		// if not prepare arg stack. copy from args
 		if (imi->args)
@@ -62,6 +72,23 @@ namespace interpreter
 		return newFrame;
 	}
 
+	InterpFrame* InterpFrameGroup::EnterFrameFromNativeWithPreparedArgs(const MethodInfo* method, const InterpMethodInfo* imi, StackObject* argBase)
+	{
+#if HYBRIDCLR_ENABLE_PROFILER
+		il2cpp_codegen_profiler_method_enter(method);
+#endif
+		// args are the topmost slots of the stack, the frame owns them and releases them on leave
+		int32_t oldStackTop = (int32_t)(argBase - _machineState.GetStackBasePtr());
+		IL2CPP_ASSERT(oldStackTop + imi->argStackObjectSize == _machineState.GetStackTop());
+		_machineState.AllocStackSlot(imi->maxStackSize - imi->argStackObjectSize);
+		BEGIN_FRAME_UPDATE();
+		InterpFrame* newFrame = _machineState.PushFrame();
+		*newFrame = { method, imi, argBase, oldStackTop, nullptr, nullptr, nullptr, 0, 0, _machineState.GetLocalPoolBottomIdx() };
+		END_FRAME_UPDATE();
+		PUSH_STACK_FRAME(method, (uintptr_t)newFrame);
+		return newFrame;
+	}
+
 	InterpFrame* InterpFrameGroup::LeaveFrame()
 	{
 		IL2CPP_ASSERT(_machineState.GetFrameTopIdx() > _frameBaseIdx);
@@ -74,7 +101,9 @@ namespace interpreter
 		{
 			_machineState.SetExceptionFlowTop(frame->exFlowBase);
 		}
+		BEGIN_FRAME_UPDATE();
 		_machineState.PopFrame();
+		END_FRAME_UPDATE();
 		_machineState.SetStackTop(frame->oldStackTop);
 		_machineState.SetLocalPoolBottomIdx(frame->oldLocalPoolBottomIdx);
 		return _machineState.GetFrameTopIdx() > _frameBaseIdx ? _machineState.GetTopFrame() : nullptr;
@@ -96,29 +125,13 @@ namespace interpreter
 	static void SetupStackFrameInfo(const InterpFrame* frame, Il2CppStackFrameInfo& stackFrame)
 	{
 		const MethodInfo* method = frame->method;
-		const InterpMethodInfo* imi = (const InterpMethodInfo*)method->interpData;
 		const byte* actualIp = (const byte*)frame->ip;
 
 		stackFrame.method = method;
 		stackFrame.raw_ip = (uintptr_t)frame;
 
-		if (!hybridclr::metadata::IsInterpreterMethod(method))
-		{
-			return;
-		}
-		
-		hybridclr::metadata::InterpreterImage* interpImage = hybridclr::metadata::MetadataModule::GetImage(method);
-		if (!interpImage)
-		{
-			return;
-		}
-
-		hybridclr::metadata::PDBImage* pdbImage = interpImage->GetPDBImage();
-		if (!pdbImage)
-		{
-			return;
-		}
-		pdbImage->SetupStackFrameInfo(method, actualIp, stackFrame);
+		// debug info is attached to InterpMethodInfo at transform time, no image lookup or lock is required.
+		hybridclr::metadata::PDBImage::SetupStackFrameInfo(frame->imi, actualIp, stackFrame);
 	}
 
 	void MachineState::CollectFrames(il2cpp::vm::StackFrames* stackFrames)
@@ -148,18 +161,37 @@ namespace interpreter
 		{
 			if (frame.method && hybridclr::metadata::IsInterpreterImplement(frame.method))
 			{
-				hybridclr::metadata::InterpreterImage* interpImage = hybridclr::metadata::MetadataModule::GetImage(frame.method);
-				if (interpImage)
-				{
-					hybridclr::metadata::PDBImage* pdbImage = interpImage->GetPDBImage();
-					if (pdbImage)
-					{
-						pdbImage->SetupStackFrameInfo(frame.method, (const byte*)(((InterpFrame*)frame.raw_ip)->ip), frame);
-					}
-				}
+				const InterpFrame* interpFrame = (const InterpFrame*)frame.raw_ip;
+				hybridclr::metadata::PDBImage::SetupStackFrameInfo(interpFrame->imi, (const byte*)interpFrame->ip, frame);
 			}
 		}
 	}
+#if HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+	bool MachineState::SnapshotFrames(std::vector<SampledFrame>& frames) const
+	{
+		frames.clear();
+		uint32_t seq = _frameSeq.load(std::memory_order_acquire);
+		if (seq & 1)
+		{
+			return false;
+		}
+		int32_t frameCount = _frameTopIdx;
+		const InterpFrame* frameBase = _frameBase;
+		if (frameCount > 0 && frameBase)
+		{
+			frames.resize(frameCount);
+			for (int32_t i = 0; i < frameCount; i++)
+			{
+				const InterpFrame* frame = frameBase + i;
+				// ip is only saved when the frame calls a sub method, so for the innermost frame it's nullptr or
+				// the ip of its last call rather than the current instruction.
+				frames[i] = { frame->method, frame->imi, frame->ip };
+			}
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return _frameSeq.load(std::memory_order_relaxed) == seq;
+	}
+#endif
 }
 }
 
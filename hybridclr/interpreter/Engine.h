@@ -4,16 +4,25 @@
 
 #include "../CommonDef.h"
 
+// HYBRIDCLR_ENABLE_SAMPLING_PROFILER is defined by CommonDef.h
+#if HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+#include <atomic>
+#include <vector>
+#endif
+
 #include "gc/GarbageCollector.h"
 #include "vm/Exception.h"
 #include "vm/StackTrace.h"
+#include "vm/Thread.h"
 
 #include "../metadata/MetadataUtil.h"
 #include "../RuntimeConfig.h"
+#include "../MemoryStats.h"
 
 #include "InterpreterDefs.h"
 #include "MemoryUtil.h"
 #include "MethodBridge.h"
+#include "SamplingProfiler.h"
 #include <algorithm>
 
 namespace hybridclr
@@ -38,23 +47,35 @@ namespace interpreter
 			_exceptionFlowBase = nullptr;
 			_exceptionFlowCount = -1;
 			_exceptionFlowTopIdx = 0;
+
+			_threadStaticData = nullptr;
+#if HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+			_frameSeq.store(0, std::memory_order_relaxed);
+			SamplingProfiler::RegisterMachineState(this);
+#endif
 		}
 
 		~MachineState()
 		{
+#if HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+			SamplingProfiler::UnregisterMachineState(this);
+#endif
 			if (_stackBase)
 			{
 				//il2cpp::gc::GarbageCollector::FreeFixed(_stackBase);
 				il2cpp::gc::GarbageCollector::UnregisterDynamicRoot(this);
 				HYBRIDCLR_FREE(_stackBase);
+				MemoryStats::OnFree(MemoryCategory::MachineState, _stackSize * sizeof(StackObject));
 			}
 			if (_frameBase)
 			{
 				HYBRIDCLR_FREE(_frameBase);
+				MemoryStats::OnFree(MemoryCategory::MachineState, _frameCount * sizeof(InterpFrame));
 			}
 			if (_exceptionFlowBase)
 			{
 				HYBRIDCLR_FREE(_exceptionFlowBase);
+				MemoryStats::OnFree(MemoryCategory::MachineState, _exceptionFlowCount * sizeof(ExceptionFlowInfo));
 			}
 		}
 
@@ -175,6 +196,23 @@ namespace interpreter
 			_frameTopIdx -= count;
 		}
 
+		// static_data of the current managed thread. the array itself is allocated once per thread,
+		// slots of classes registered later are filled in place, so caching the array is safe.
+		void* GetThreadStaticData(int32_t offset)
+		{
+			if (!_threadStaticData)
+			{
+				_threadStaticData = il2cpp::vm::Thread::Current()->GetInternalThread()->static_data;
+			}
+			return _threadStaticData[offset];
+		}
+
+		// the managed thread may be detached and attached again between two outermost interpreter calls.
+		void ResetThreadStaticDataCache()
+		{
+			_threadStaticData = nullptr;
+		}
+
 		InterpFrame* GetTopFrame() const
 		{
 			if (_frameTopIdx > 0)
@@ -246,6 +284,24 @@ namespace interpreter
 		void CollectFrames(il2cpp::vm::StackFrames* stackFrames);
 		void SetupFramesDebugInfo(il2cpp::vm::StackFrames* stackFrames);
 
+#if HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+		// seqlock around frame push/pop, so that the sampling profiler thread can read frames of this thread.
+		void BeginFrameUpdate()
+		{
+			uint32_t seq = _frameSeq.load(std::memory_order_relaxed);
+			_frameSeq.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+
+		void EndFrameUpdate()
+		{
+			_frameSeq.store(_frameSeq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		// called from the sampling thread. return false if frames were changing while being copied.
+		bool SnapshotFrames(std::vector<SampledFrame>& frames) const;
+#endif
+
 	private:
 
 
@@ -253,6 +309,7 @@ namespace interpreter
 		{
 			_stackSize = (int32_t)RuntimeConfig::GetInterpreterThreadObjectStackSize();
 			_stackBase = (StackObject*)HYBRIDCLR_MALLOC_ZERO(RuntimeConfig::GetInterpreterThreadObjectStackSize() * sizeof(StackObject));
+			MemoryStats::OnAllocate(MemoryCategory::MachineState, _stackSize * sizeof(StackObject));
 			_stackTopIdx = 0;
 			_localPoolBottomIdx = _stackSize;
 			il2cpp::gc::GarbageCollector::RegisterDynamicRoot(this, GetGCRootData);
@@ -262,6 +319,7 @@ namespace interpreter
 		{
 			_frameBase = (InterpFrame*)HYBRIDCLR_CALLOC(RuntimeConfig::GetInterpreterThreadFrameStackSize(), sizeof(InterpFrame));
 			_frameCount = (int32_t)RuntimeConfig::GetInterpreterThreadFrameStackSize();
+			MemoryStats::OnAllocate(MemoryCategory::MachineState, _frameCount * sizeof(InterpFrame));
 			_frameTopIdx = 0;
 		}
 
@@ -269,6 +327,7 @@ namespace interpreter
 		{
 			_exceptionFlowBase = (ExceptionFlowInfo*)HYBRIDCLR_CALLOC(RuntimeConfig::GetInterpreterThreadExceptionFlowSize(), sizeof(ExceptionFlowInfo));
 			_exceptionFlowCount = (int32_t)RuntimeConfig::GetInterpreterThreadExceptionFlowSize();
+			MemoryStats::OnAllocate(MemoryCategory::MachineState, _exceptionFlowCount * sizeof(ExceptionFlowInfo));
 			_exceptionFlowTopIdx = 0;
 		}
 
@@ -285,8 +344,13 @@ namespace interpreter
 		int32_t _exceptionFlowTopIdx;
 		int32_t _exceptionFlowCount;
 
+		void** _threadStaticData;
 
 		std::stack<const Il2CppImage*> _executingImageStack;
+
+#if HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+		std::atomic<uint32_t> _frameSeq;
+#endif
 	};
 
 	class ExecutingInterpImageScope
@@ -306,6 +370,32 @@ namespace interpreter
 		MachineState& _state;
 	};
 
+	// argument slots allocated on top of the MachineState stack by a native caller. the caller converts the
+	// arguments into them and passes them to Interpreter::ExecuteWithPreparedArgs, whose frame uses them in place.
+	// the slots are released when the scope ends, even if the call throws before the frame is entered.
+	class NativeCallArgsScope
+	{
+	public:
+		NativeCallArgsScope(MachineState& state, int32_t argStackObjectSize) : _state(state), _oldStackTop(state.GetStackTop())
+		{
+			_args = state.AllocArgments(argStackObjectSize);
+		}
+
+		~NativeCallArgsScope()
+		{
+			_state.SetStackTop(_oldStackTop);
+		}
+
+		StackObject* GetArgs() const { return _args; }
+
+		MachineState& GetMachineState() const { return _state; }
+
+	private:
+		MachineState& _state;
+		int32_t _oldStackTop;
+		StackObject* _args;
+	};
+
 	class InterpFrameGroup
 	{
 	public:
@@ -327,9 +417,11 @@ namespace interpreter
 			}
 		}
 
-		InterpFrame* EnterFrameFromInterpreter(const MethodInfo* method, StackObject* argBase);
+		InterpFrame* EnterFrameFromInterpreter(const MethodInfo* method, const InterpMethodInfo* imi, StackObject* argBase);
+
+		InterpFrame* EnterFrameFromNative(const MethodInfo* method, const InterpMethodInfo* imi, StackObject* argBase);
 
-		InterpFrame* EnterFrameFromNative(const MethodInfo* method, StackObject* argBase);
+		InterpFrame* EnterFrameFromNativeWithPreparedArgs(const MethodInfo* method, const InterpMethodInfo* imi, StackObject* argBase);
 
 		InterpFrame* LeaveFrame();
 
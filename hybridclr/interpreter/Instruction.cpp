@@ -300,6 +300,8 @@ namespace interpreter
 		16,
 		16,
 		16,
+		16,
+		16,
 		8,
 		16,
 		16,
@@ -557,6 +559,8 @@ namespace interpreter
 		16,
 		8,
 		8,
+		16,
+		16,
 		8,
 		16,
 		8,
@@ -842,6 +846,27 @@ namespace interpreter
 		8,
 		8,
 		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
+		8,
 		16,
 		16,
 		8,
@@ -315,6 +315,8 @@ namespace interpreter
 		NewValueTypeVar_Ctor_0,
 		NewClassInterpVar,
 		NewClassInterpVar_Ctor_0,
+		NewClassInterpStackVar,
+		NewClassInterpStackVar_Ctor_0,
 		NewValueTypeInterpVar,
 		AdjustValueTypeRefVar,
 		BoxRefVarVar,
@@ -573,6 +575,8 @@ namespace interpreter
 		UnBoxAnyVarVar,
 		CastclassVar,
 		IsInstVar,
+		CastclassCacheVar,
+		IsInstCacheVar,
 		LdtokenVar,
 		MakeRefVarVar,
 		RefAnyTypeVarVar,
@@ -826,6 +830,7 @@ namespace interpreter
 		GetArrayLengthVarVar,
 		GetArrayElementAddressAddrVarVar,
 		GetArrayElementAddressCheckAddrVarVar,
+		GetArrayElementAddressUncheckedAddrVarVar,
 		GetArrayElementVarVar_i1,
 		GetArrayElementVarVar_u1,
 		GetArrayElementVarVar_i2,
@@ -845,6 +850,16 @@ namespace interpreter
 		GetArrayElementVarVar_size_28,
 		GetArrayElementVarVar_size_32,
 		GetArrayElementVarVar_n,
+		GetArrayElementUncheckedVarVar_i1,
+		GetArrayElementUncheckedVarVar_u1,
+		GetArrayElementUncheckedVarVar_i2,
+		GetArrayElementUncheckedVarVar_u2,
+		GetArrayElementUncheckedVarVar_i4,
+		GetArrayElementUncheckedVarVar_u4,
+		GetArrayElementUncheckedVarVar_i8,
+		GetArrayElementUncheckedVarVar_u8,
+		GetArrayElementUncheckedVarVar_size_12,
+		GetArrayElementUncheckedVarVar_size_16,
 		SetArrayElementVarVar_i1,
 		SetArrayElementVarVar_u1,
 		SetArrayElementVarVar_i2,
@@ -858,6 +873,16 @@ namespace interpreter
 		SetArrayElementVarVar_size_16,
 		SetArrayElementVarVar_n,
 		SetArrayElementVarVar_WriteBarrier_n,
+		SetArrayElementUncheckedVarVar_i1,
+		SetArrayElementUncheckedVarVar_u1,
+		SetArrayElementUncheckedVarVar_i2,
+		SetArrayElementUncheckedVarVar_u2,
+		SetArrayElementUncheckedVarVar_i4,
+		SetArrayElementUncheckedVarVar_u4,
+		SetArrayElementUncheckedVarVar_i8,
+		SetArrayElementUncheckedVarVar_u8,
+		SetArrayElementUncheckedVarVar_size_12,
+		SetArrayElementUncheckedVarVar_size_16,
 		NewMdArrVarVar_length,
 		NewMdArrVarVar_length_bound,
 		GetMdArrElementVarVar_i1,
@@ -3683,6 +3708,28 @@ namespace interpreter
 	};
 
 
+	struct IRNewClassInterpStackVar : IRCommon
+	{
+		uint16_t obj;
+		uint16_t argBase;
+		uint16_t argStackObjectNum;
+		uint16_t ctorFrameBase;
+		uint16_t storage;
+		uint32_t method;
+	};
+
+
+	struct IRNewClassInterpStackVar_Ctor_0 : IRCommon
+	{
+		uint16_t obj;
+		uint16_t ctorFrameBase;
+		uint16_t storage;
+		uint8_t __pad8;
+		uint8_t __pad9;
+		uint32_t method;
+	};
+
+
 	struct IRNewValueTypeInterpVar : IRCommon
 	{
 		uint16_t obj;
@@ -6882,6 +6929,30 @@ namespace interpreter
 	};
 
 
+	struct IRCastclassCacheVar : IRCommon
+	{
+		uint16_t obj;
+		uint32_t klass;
+		uint32_t cache;
+		uint8_t __pad12;
+		uint8_t __pad13;
+		uint8_t __pad14;
+		uint8_t __pad15;
+	};
+
+
+	struct IRIsInstCacheVar : IRCommon
+	{
+		uint16_t obj;
+		uint32_t klass;
+		uint32_t cache;
+		uint8_t __pad12;
+		uint8_t __pad13;
+		uint8_t __pad14;
+		uint8_t __pad15;
+	};
+
+
 	struct IRLdtokenVar : IRCommon
 	{
 		uint16_t runtimeHandle;
@@ -9661,6 +9732,14 @@ namespace interpreter
 	};
 
 
+	struct IRGetArrayElementAddressUncheckedAddrVarVar : IRCommon
+	{
+		uint16_t addr;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
 	struct IRGetArrayElementVarVar_i1 : IRCommon
 	{
 		uint16_t dst;
@@ -9813,6 +9892,86 @@ namespace interpreter
 	};
 
 
+	struct IRGetArrayElementUncheckedVarVar_i1 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_u1 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_i2 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_u2 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_i4 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_u4 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_i8 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_u8 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_size_12 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
+	struct IRGetArrayElementUncheckedVarVar_size_16 : IRCommon
+	{
+		uint16_t dst;
+		uint16_t arr;
+		uint16_t index;
+	};
+
+
 	struct IRSetArrayElementVarVar_i1 : IRCommon
 	{
 		uint16_t arr;
@@ -9917,6 +10076,86 @@ namespace interpreter
 	};
 
 
+	struct IRSetArrayElementUncheckedVarVar_i1 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_u1 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_i2 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_u2 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_i4 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_u4 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_i8 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_u8 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_size_12 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
+	struct IRSetArrayElementUncheckedVarVar_size_16 : IRCommon
+	{
+		uint16_t arr;
+		uint16_t index;
+		uint16_t ele;
+	};
+
+
 	struct IRNewMdArrVarVar_length : IRCommon
 	{
 		uint16_t arr;
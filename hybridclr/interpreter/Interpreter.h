@@ -8,12 +8,21 @@ namespace hybridclr
 namespace interpreter
 {
 
+	class MachineState;
+	class NativeCallArgsScope;
+
 	class Interpreter
 	{
 	public:
 
 		static void Execute(const MethodInfo* methodInfo, StackObject* args, void* ret);
 
+		// the args of argsScope, opened right before the call, become the arguments of the new frame without
+		// being copied again. the MachineState is taken from the scope instead of being looked up again.
+		static void ExecuteWithPreparedArgs(const MethodInfo* methodInfo, NativeCallArgsScope& argsScope, void* ret);
+
+	private:
+		static void Execute(MachineState& machine, const MethodInfo* methodInfo, StackObject* args, void* ret, bool argsPrepared);
 	};
 
 }
@@ -4,6 +4,11 @@
 
 namespace hybridclr
 {
+	namespace metadata
+	{
+		struct MethodDebugInfo;
+	}
+
 	namespace interpreter
 	{
 
@@ -62,6 +67,8 @@ namespace hybridclr
 		struct InterpFrame
 		{
 			const MethodInfo* method;
+			// captured on enter, so the frame keeps running the same code if method is hot reloaded meanwhile
+			const InterpMethodInfo* imi;
 			StackObject* stackBasePtr;
 			int32_t oldStackTop;
 			void* ret;
@@ -118,6 +125,12 @@ namespace hybridclr
 			uint32_t localVarBaseOffset;
 			uint32_t evalStackBaseOffset;
 			uint32_t exClauseCount;
+			uint32_t initLocalsSkippedSize; // bytes of locals left uncleared by InitLocals
+			uint32_t inlineeCount;
+			const metadata::MethodDebugInfo* debugInfo;
+			// distinct methods whose body was copied into codes: inlined callees at any depth, and constructors
+			// the escape analysis relied on. the code must be transformed again when one of them changes.
+			const MethodInfo* const* inlinees;
 		};
 	}
 }
\ No newline at end of file
@@ -37,6 +37,8 @@ namespace interpreter
 	static Il2CppHashMap<const char*, int32_t, CStringHash, CStringEqualTo> s_methodSig2Indexs;
 	static std::vector<ReversePInvokeInfo> s_reverseInfos;
 
+	static Il2CppHashSet<const MethodInfo*, il2cpp::utils::PointerHash<MethodInfo>> s_transformedMethods;
+
 	static Il2CppHashMap<const char*, Managed2NativeFunctionPointerCallMethod, CStringHash, CStringEqualTo> s_managed2nativeFunctionPointers;
 
 	static std::unordered_map<void*, bool> s_functionPointerMap;
@@ -418,9 +420,10 @@ namespace interpreter
 	
 	static void InterpreterInvoke(Il2CppMethodPointer methodPointer, const MethodInfo* method, void* __this, void** __args, void* __ret)
 	{
-		InterpMethodInfo* imi = method->interpData ? (InterpMethodInfo*)method->interpData : InterpreterModule::GetInterpMethodInfo(method);
+		InterpMethodInfo* imi = InterpreterModule::GetOrTransformInterpMethodInfo(method);
 		bool isInstanceMethod = metadata::IsInstanceMethod(method);
-		StackObject* args = (StackObject*)alloca(sizeof(StackObject) * imi->argStackObjectSize);
+		NativeCallArgsScope argsScope(InterpreterModule::GetCurrentThreadMachineState(), imi->argStackObjectSize);
+		StackObject* args = argsScope.GetArgs();
 		if (isInstanceMethod)
 		{
 			if (IS_CLASS_VALUE_TYPE(method->klass))
@@ -432,7 +435,7 @@ namespace interpreter
 		
 		MethodArgDesc* argDescs = imi->args + isInstanceMethod;
 		ConvertInvokeArgs(args + isInstanceMethod, method, argDescs, __args);
-		Interpreter::Execute(method, args, __ret);
+		Interpreter::ExecuteWithPreparedArgs(method, argsScope, __ret);
 	}
 
 	static void InterpreterDelegateInvoke(Il2CppMethodPointer, const MethodInfo* method, void* __this, void** __args, void* __ret)
@@ -511,8 +514,9 @@ namespace interpreter
 	#else
 	static void* InterpreterInvoke(Il2CppMethodPointer methodPointer, const MethodInfo* method, void* __this, void** __args)
 	{
-		InterpMethodInfo* imi = method->interpData ? (InterpMethodInfo*)method->interpData : InterpreterModule::GetInterpMethodInfo(method);
-		StackObject* args = (StackObject*)alloca(sizeof(StackObject) * imi->argStackObjectSize);
+		InterpMethodInfo* imi = InterpreterModule::GetOrTransformInterpMethodInfo(method);
+		NativeCallArgsScope argsScope(InterpreterModule::GetCurrentThreadMachineState(), imi->argStackObjectSize);
+		StackObject* args = argsScope.GetArgs();
 		bool isInstanceMethod = metadata::IsInstanceMethod(method);
 		if (isInstanceMethod)
 		{
@@ -526,13 +530,13 @@ namespace interpreter
 		ConvertInvokeArgs(args + isInstanceMethod, method, argDescs, __args);
 		if (method->return_type->type == IL2CPP_TYPE_VOID)
 		{
-			Interpreter::Execute(method, args, nullptr);
+			Interpreter::ExecuteWithPreparedArgs(method, argsScope, nullptr);
 			return nullptr;
 		}
 		else
 		{
 			StackObject* ret = (StackObject*)alloca(sizeof(StackObject) * imi->retStackObjectSize);
-			Interpreter::Execute(method, args, ret);
+			Interpreter::ExecuteWithPreparedArgs(method, argsScope, ret);
 			return TranslateNativeValueToBoxValue(method->return_type, ret);
 		}
 	}
@@ -646,8 +650,65 @@ namespace interpreter
 		InterpMethodInfo* imi = transform::HiTransform::Transform(methodInfo);
 		il2cpp::os::Atomic::FullMemoryBarrier();
 		const_cast<MethodInfo*>(methodInfo)->interpData = imi;
+		s_transformedMethods.insert(methodInfo);
 		return imi;
 	}
+
+	const Il2CppHashSet<const MethodInfo*, il2cpp::utils::PointerHash<MethodInfo>>& InterpreterModule::GetTransformedMethods()
+	{
+		return s_transformedMethods;
+	}
+
+	void InterpreterModule::GetDependentMethods(const std::function<bool(const MethodInfo*)>& isInlinee, std::vector<const MethodInfo*>& dependents)
+	{
+		for (const MethodInfo* method : s_transformedMethods)
+		{
+			const InterpMethodInfo* imi = (const InterpMethodInfo*)method->interpData;
+			if (!imi)
+			{
+				continue;
+			}
+			for (uint32_t i = 0; i < imi->inlineeCount; i++)
+			{
+				if (isInlinee(imi->inlinees[i]))
+				{
+					dependents.push_back(method);
+					break;
+				}
+			}
+		}
+	}
+
+	void InterpreterModule::RetransformMethods(const std::vector<const MethodInfo*>& methods)
+	{
+		il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
+
+		// old InterpMethodInfos are never freed, frames still running them or a sampler may hold them
+		std::vector<InterpMethodInfo*> imis;
+		imis.reserve(methods.size());
+		for (const MethodInfo* method : methods)
+		{
+			imis.push_back(transform::HiTransform::Transform(method));
+		}
+		il2cpp::os::Atomic::FullMemoryBarrier();
+		for (size_t i = 0; i < methods.size(); i++)
+		{
+			const_cast<MethodInfo*>(methods[i])->interpData = imis[i];
+		}
+	}
+
+	int32_t InterpreterModule::RetransformDependentMethods(const MethodInfo* method)
+	{
+		il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
+
+		std::vector<const MethodInfo*> dependents;
+		GetDependentMethods([method](const MethodInfo* inlinee)
+			{
+				return inlinee == method || (inlinee->is_inflated && inlinee->genericMethod->methodDefinition == method);
+			}, dependents);
+		RetransformMethods(dependents);
+		return (int32_t)dependents.size();
+	}
 }
 }
 
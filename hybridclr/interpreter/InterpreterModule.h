@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <vector>
+
 #include "os/ThreadLocalValue.h"
 
 #include "../CommonDef.h"
@@ -42,6 +46,30 @@ namespace interpreter
 
 		static InterpMethodInfo* GetInterpMethodInfo(const MethodInfo* methodInfo);
 
+		// interpData is published after a barrier by the first transform and by RetransformMethods, which may swap it
+		// concurrently. it's read once with acquire, so the InterpMethodInfo it points to is fully visible.
+		static InterpMethodInfo* GetOrTransformInterpMethodInfo(const MethodInfo* methodInfo)
+		{
+			static_assert(sizeof(std::atomic<void*>) == sizeof(void*), "interpData can't be read as std::atomic<void*>");
+			InterpMethodInfo* imi = (InterpMethodInfo*)reinterpret_cast<const std::atomic<void*>*>(&methodInfo->interpData)->load(std::memory_order_acquire);
+			return imi ? imi : GetInterpMethodInfo(methodInfo);
+		}
+
+		// every method transformed so far. callers must hold g_MetadataLock.
+		static const Il2CppHashSet<const MethodInfo*, il2cpp::utils::PointerHash<MethodInfo>>& GetTransformedMethods();
+
+		// transformed methods whose current code copied the body of a method matching isInlinee, see InterpMethodInfo::inlinees.
+		// callers must hold g_MetadataLock.
+		static void GetDependentMethods(const std::function<bool(const MethodInfo*)>& isInlinee, std::vector<const MethodInfo*>& dependents);
+
+		// transforms methods again and publishes the new code only if every transform succeeds.
+		// frames already running keep the code they entered with.
+		static void RetransformMethods(const std::vector<const MethodInfo*>& methods);
+
+		// re-transforms the methods that inlined method, or any instantiation of it if it's a generic definition.
+		// returns the number of re-transformed methods.
+		static int32_t RetransformDependentMethods(const MethodInfo* method);
+
 		static Il2CppMethodPointer GetMethodPointer(const Il2CppMethodDefinition* method);
 		static Il2CppMethodPointer GetMethodPointer(const MethodInfo* method);
 		static Il2CppMethodPointer GetAdjustThunkMethodPointer(const Il2CppMethodDefinition* method);
@@ -774,6 +774,43 @@ namespace interpreter
 		}
 	}
 
+	// per call site cache of the last seen object class. low bit holds the check result.
+	// the slot is a single pointer sized word, so racing threads only ever overwrite a valid entry with another valid one.
+	inline bool HiIsInstanceOfCached(Il2CppObject* obj, Il2CppClass* klass, uint64_t* cacheSlot)
+	{
+		uintptr_t* cache = (uintptr_t*)cacheSlot;
+		uintptr_t cached = *cache;
+		if ((cached & ~(uintptr_t)1) != (uintptr_t)obj->klass)
+		{
+			cached = (uintptr_t)obj->klass | (il2cpp::vm::Object::IsInst(obj, klass) ? 1 : 0);
+			*cache = cached;
+		}
+		return cached & 1;
+	}
+
+	inline void HiCastClassCached(Il2CppObject* obj, Il2CppClass* klass, uint64_t* cacheSlot)
+	{
+		if (obj != nullptr && !HiIsInstanceOfCached(obj, klass, cacheSlot))
+		{
+			il2cpp::vm::Exception::Raise(il2cpp::vm::Exception::GetInvalidCastException("cast fail"), nullptr);
+		}
+	}
+
+	inline Il2CppObject* HiIsInstCached(Il2CppObject* obj, Il2CppClass* klass, uint64_t* cacheSlot)
+	{
+		return obj != nullptr && HiIsInstanceOfCached(obj, klass, cacheSlot) ? obj : nullptr;
+	}
+
+	// object placed in the frame by the transformer. it never escapes the frame, so the gc sees it only through
+	// the conservatively scanned interpreter stack.
+	inline Il2CppObject* HiNewStackObject(Il2CppClass* klass, void* storage)
+	{
+		std::memset(storage, 0, klass->instance_size);
+		Il2CppObject* obj = (Il2CppObject*)storage;
+		obj->klass = klass;
+		return obj;
+	}
+
 	inline Il2CppTypedRef MAKE_TYPEDREFERENCE(Il2CppClass* klazz, void* ptr)
 	{
 		return Il2CppTypedRef{ &klazz->byval_arg, ptr, klazz };
@@ -1265,16 +1302,16 @@ namespace interpreter
 }
 
 #define LOAD_PREV_FRAME() { \
-	imi = (const InterpMethodInfo*)frame->method->interpData; \
+	imi = frame->imi; \
 	ip = frame->ip; \
 	ipBase = imi->codes; \
 	localVarBase = frame->stackBasePtr; \
 }
 
-#define PREPARE_NEW_FRAME_FROM_NATIVE(newMethodInfo, argBasePtr, retPtr) { \
-	imi = newMethodInfo->interpData ? (InterpMethodInfo*)newMethodInfo->interpData : InterpreterModule::GetInterpMethodInfo(newMethodInfo); \
+#define PREPARE_NEW_FRAME_FROM_NATIVE(newMethodInfo, argBasePtr, retPtr, argsPrepared) { \
+	imi = InterpreterModule::GetOrTransformInterpMethodInfo(newMethodInfo); \
 	RuntimeInitClassCCtorWithoutInitClass(newMethodInfo); \
-	frame = interpFrameGroup.EnterFrameFromNative(newMethodInfo, argBasePtr); \
+	frame = argsPrepared ? interpFrameGroup.EnterFrameFromNativeWithPreparedArgs(newMethodInfo, imi, argBasePtr) : interpFrameGroup.EnterFrameFromNative(newMethodInfo, imi, argBasePtr); \
 	frame->ret = retPtr; \
 	ip = ipBase = imi->codes; \
 	frame->ip = (byte*)ip; \
@@ -1282,9 +1319,9 @@ namespace interpreter
 }
 
 #define PREPARE_NEW_FRAME_FROM_INTERPRETER(newMethodInfo, argBasePtr, retPtr) { \
-	imi = newMethodInfo->interpData ? (InterpMethodInfo*)newMethodInfo->interpData : InterpreterModule::GetInterpMethodInfo(newMethodInfo); \
+	imi = InterpreterModule::GetOrTransformInterpMethodInfo(newMethodInfo); \
 	RuntimeInitClassCCtorWithoutInitClass(newMethodInfo); \
-	frame = interpFrameGroup.EnterFrameFromInterpreter(newMethodInfo, argBasePtr); \
+	frame = interpFrameGroup.EnterFrameFromInterpreter(newMethodInfo, imi, argBasePtr); \
 	frame->ret = retPtr; \
 	ip = ipBase = imi->codes; \
 	frame->ip = (byte*)ip; \
@@ -1668,7 +1705,20 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 
 	void Interpreter::Execute(const MethodInfo* methodInfo, StackObject* args, void* ret)
 	{
-		MachineState& machine = InterpreterModule::GetCurrentThreadMachineState();
+		Execute(InterpreterModule::GetCurrentThreadMachineState(), methodInfo, args, ret, false);
+	}
+
+	void Interpreter::ExecuteWithPreparedArgs(const MethodInfo* methodInfo, NativeCallArgsScope& argsScope, void* ret)
+	{
+		Execute(argsScope.GetMachineState(), methodInfo, argsScope.GetArgs(), ret, true);
+	}
+
+	void Interpreter::Execute(MachineState& machine, const MethodInfo* methodInfo, StackObject* args, void* ret, bool argsPrepared)
+	{
+		if (machine.GetFrameTopIdx() == 0)
+		{
+			machine.ResetThreadStaticDataCache();
+		}
 		InterpFrameGroup interpFrameGroup(machine);
 
 		const InterpMethodInfo* imi;
@@ -1680,7 +1730,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 		Il2CppException* lastUnwindException;
 		StackObject* tempRet = nullptr;
 
-		PREPARE_NEW_FRAME_FROM_NATIVE(methodInfo, args, ret);
+		PREPARE_NEW_FRAME_FROM_NATIVE(methodInfo, args, ret, argsPrepared);
 
 	LoopStart:
 		try
@@ -4807,6 +4857,37 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 				    CALL_INTERP_VOID((ip + 16), __method, _frameBasePtr);
 				    continue;
 				}
+				case HiOpcodeEnum::NewClassInterpStackVar:
+				{
+					uint16_t __obj = *(uint16_t*)(ip + 2);
+					MethodInfo* __method = ((MethodInfo*)imi->resolveDatas[*(uint32_t*)(ip + 12)]);
+					uint16_t __argBase = *(uint16_t*)(ip + 4);
+					uint16_t __argStackObjectNum = *(uint16_t*)(ip + 6);
+					uint16_t __ctorFrameBase = *(uint16_t*)(ip + 8);
+					uint16_t __storage = *(uint16_t*)(ip + 10);
+				    IL2CPP_ASSERT(__obj < __ctorFrameBase);
+				    Il2CppObject* _newObj = HiNewStackObject(__method->klass, (void*)(localVarBase + __storage));
+				    StackObject* _frameBasePtr = (StackObject*)(void*)(localVarBase + __ctorFrameBase);
+				    std::memmove(_frameBasePtr + 1, (void*)(localVarBase + __argBase), __argStackObjectNum * sizeof(StackObject)); // move arg
+				    _frameBasePtr->obj = _newObj; // prepare this 
+				    (*(Il2CppObject**)(localVarBase + __obj)) = _newObj; // set must after move
+				    CALL_INTERP_VOID((ip + 16), __method, _frameBasePtr);
+				    continue;
+				}
+				case HiOpcodeEnum::NewClassInterpStackVar_Ctor_0:
+				{
+					uint16_t __obj = *(uint16_t*)(ip + 2);
+					MethodInfo* __method = ((MethodInfo*)imi->resolveDatas[*(uint32_t*)(ip + 12)]);
+					uint16_t __ctorFrameBase = *(uint16_t*)(ip + 4);
+					uint16_t __storage = *(uint16_t*)(ip + 6);
+				    IL2CPP_ASSERT(__obj < __ctorFrameBase);
+				    Il2CppObject* _newObj = HiNewStackObject(__method->klass, (void*)(localVarBase + __storage));
+				    StackObject* _frameBasePtr = (StackObject*)(void*)(localVarBase + __ctorFrameBase);
+				    _frameBasePtr->obj = _newObj; // prepare this 
+				    (*(Il2CppObject**)(localVarBase + __obj)) = _newObj;
+				    CALL_INTERP_VOID((ip + 16), __method, _frameBasePtr);
+				    continue;
+				}
 				case HiOpcodeEnum::NewValueTypeInterpVar:
 				{
 					uint16_t __obj = *(uint16_t*)(ip + 2);
@@ -8846,6 +8927,24 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 				    ip += 8;
 				    continue;
 				}
+				case HiOpcodeEnum::CastclassCacheVar:
+				{
+					uint16_t __obj = *(uint16_t*)(ip + 2);
+					uint32_t __klass = *(uint32_t*)(ip + 4);
+					uint32_t __cache = *(uint32_t*)(ip + 8);
+				    HiCastClassCached((*(Il2CppObject**)(localVarBase + __obj)), ((Il2CppClass*)imi->resolveDatas[__klass]), imi->resolveDatas + __cache);
+				    ip += 16;
+				    continue;
+				}
+				case HiOpcodeEnum::IsInstCacheVar:
+				{
+					uint16_t __obj = *(uint16_t*)(ip + 2);
+					uint32_t __klass = *(uint32_t*)(ip + 4);
+					uint32_t __cache = *(uint32_t*)(ip + 8);
+				    (*(Il2CppObject**)(localVarBase + __obj)) = HiIsInstCached((*(Il2CppObject**)(localVarBase + __obj)), ((Il2CppClass*)imi->resolveDatas[__klass]), imi->resolveDatas + __cache);
+				    ip += 16;
+				    continue;
+				}
 				case HiOpcodeEnum::LdtokenVar:
 				{
 					uint16_t __runtimeHandle = *(uint16_t*)(ip + 2);
@@ -10308,7 +10407,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(void**)(localVarBase + __dst)) = (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset;
+				    (*(void**)(localVarBase + __dst)) = (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset;
 				    ip += 16;
 				    continue;
 				}
@@ -10318,7 +10417,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(int32_t*)(localVarBase + __dst)) = *(int8_t*)((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    (*(int32_t*)(localVarBase + __dst)) = *(int8_t*)((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10328,7 +10427,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(int32_t*)(localVarBase + __dst)) = *(uint8_t*)((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    (*(int32_t*)(localVarBase + __dst)) = *(uint8_t*)((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10338,7 +10437,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(int32_t*)(localVarBase + __dst)) = *(int16_t*)((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    (*(int32_t*)(localVarBase + __dst)) = *(int16_t*)((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10348,7 +10447,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(int32_t*)(localVarBase + __dst)) = *(uint16_t*)((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    (*(int32_t*)(localVarBase + __dst)) = *(uint16_t*)((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10358,7 +10457,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(int32_t*)(localVarBase + __dst)) = *(int32_t*)((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    (*(int32_t*)(localVarBase + __dst)) = *(int32_t*)((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10368,7 +10467,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(int32_t*)(localVarBase + __dst)) = *(uint32_t*)((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    (*(int32_t*)(localVarBase + __dst)) = *(uint32_t*)((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10378,7 +10477,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(int64_t*)(localVarBase + __dst)) = *(int64_t*)((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    (*(int64_t*)(localVarBase + __dst)) = *(int64_t*)((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10388,7 +10487,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    (*(int64_t*)(localVarBase + __dst)) = *(uint64_t*)((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    (*(int64_t*)(localVarBase + __dst)) = *(uint64_t*)((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10398,7 +10497,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy8((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    Copy8((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10408,7 +10507,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy12((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    Copy12((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10418,7 +10517,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy16((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    Copy16((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10428,7 +10527,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy20((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    Copy20((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10438,7 +10537,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy24((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    Copy24((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10448,7 +10547,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy28((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    Copy28((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10458,7 +10557,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					Il2CppClass* __klass = ((Il2CppClass*)imi->resolveDatas[*(uint32_t*)(ip + 4)]);
 					int32_t __offset = *(int32_t*)(ip + 8);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy32((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
+				    Copy32((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset);
 				    ip += 16;
 				    continue;
 				}
@@ -10469,7 +10568,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					int32_t __offset = *(int32_t*)(ip + 12);
 					uint16_t __size = *(uint16_t*)(ip + 4);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    std::memmove((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset, __size);
+				    std::memmove((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset, __size);
 				    ip += 16;
 				    continue;
 				}
@@ -10480,7 +10579,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					int32_t __offset = *(int32_t*)(ip + 8);
 					uint32_t __size = *(uint32_t*)(ip + 12);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    std::memmove((void*)(localVarBase + __dst), (byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset, __size);
+				    std::memmove((void*)(localVarBase + __dst), (byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset, __size);
 				    ip += 16;
 				    continue;
 				}
@@ -10490,7 +10589,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(int8_t*)_fieldAddr_ = (*(int8_t*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
@@ -10501,7 +10600,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(uint8_t*)_fieldAddr_ = (*(uint8_t*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
@@ -10512,7 +10611,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(int16_t*)_fieldAddr_ = (*(int16_t*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
@@ -10523,7 +10622,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(uint16_t*)_fieldAddr_ = (*(uint16_t*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
@@ -10534,7 +10633,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(int32_t*)_fieldAddr_ = (*(int32_t*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
@@ -10545,7 +10644,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(uint32_t*)_fieldAddr_ = (*(uint32_t*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
@@ -10556,7 +10655,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(int64_t*)_fieldAddr_ = (*(int64_t*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
@@ -10567,7 +10666,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(uint64_t*)_fieldAddr_ = (*(uint64_t*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
@@ -10578,7 +10677,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    *(Il2CppObject**)_fieldAddr_ = (*(Il2CppObject**)(localVarBase + __data));HYBRIDCLR_SET_WRITE_BARRIER((void**)_fieldAddr_);
 				    ip += 16;
 				    continue;
@@ -10589,7 +10688,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy8((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
+				    Copy8((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
 				}
@@ -10599,7 +10698,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy12((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
+				    Copy12((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
 				}
@@ -10609,7 +10708,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy16((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
+				    Copy16((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
 				}
@@ -10619,7 +10718,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy20((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
+				    Copy20((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
 				}
@@ -10629,7 +10728,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy24((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
+				    Copy24((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
 				}
@@ -10639,7 +10738,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy28((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
+				    Copy28((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
 				}
@@ -10649,7 +10748,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint32_t __offset = *(uint32_t*)(ip + 4);
 					uint16_t __data = *(uint16_t*)(ip + 2);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    Copy32((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
+				    Copy32((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset)) + __offset, (void*)(localVarBase + __data));
 				    ip += 16;
 				    continue;
 				}
@@ -10660,7 +10759,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint16_t __data = *(uint16_t*)(ip + 2);
 					uint16_t __size = *(uint16_t*)(ip + 4);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    std::memmove((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset, (void*)(localVarBase + __data), __size);
+				    std::memmove((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset, (void*)(localVarBase + __data), __size);
 				    ip += 16;
 				    continue;
 				}
@@ -10671,7 +10770,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint16_t __data = *(uint16_t*)(ip + 2);
 					uint32_t __size = *(uint32_t*)(ip + 12);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    std::memmove((byte*)il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset) + __offset, (void*)(localVarBase + __data), __size);
+				    std::memmove((byte*)machine.GetThreadStaticData(__klass->thread_static_fields_offset) + __offset, (void*)(localVarBase + __data), __size);
 				    ip += 16;
 				    continue;
 				}
@@ -10682,7 +10781,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint16_t __data = *(uint16_t*)(ip + 2);
 					uint16_t __size = *(uint16_t*)(ip + 4);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    std::memmove(_fieldAddr_, (void*)(localVarBase + __data), __size);
 				    HYBRIDCLR_SET_WRITE_BARRIER((void**)_fieldAddr_, (size_t)__size);
 				    ip += 16;
@@ -10695,7 +10794,7 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 					uint16_t __data = *(uint16_t*)(ip + 2);
 					uint32_t __size = *(uint32_t*)(ip + 12);
 				    RuntimeInitClassCCtorWithoutInitClass(__klass);
-				    void* _fieldAddr_ = ((byte*)(il2cpp::vm::Thread::GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
+				    void* _fieldAddr_ = ((byte*)(machine.GetThreadStaticData(__klass->thread_static_fields_offset))) + __offset;
 				    std::memmove(_fieldAddr_, (void*)(localVarBase + __data), __size);
 				    HYBRIDCLR_SET_WRITE_BARRIER((void**)_fieldAddr_, (size_t)__size);
 				    ip += 16;
@@ -11317,6 +11416,16 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 				    ip += 16;
 				    continue;
 				}
+				case HiOpcodeEnum::GetArrayElementAddressUncheckedAddrVarVar:
+				{
+					uint16_t __addr = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(void**)(localVarBase + __addr)) = GET_ARRAY_ELEMENT_ADDRESS(arr, (*(int32_t*)(localVarBase + __index)), il2cpp::vm::Array::GetElementSize(arr->klass));
+				    ip += 8;
+				    continue;
+				}
 				case HiOpcodeEnum::GetArrayElementVarVar_i1:
 				{
 					uint16_t __dst = *(uint16_t*)(ip + 2);
@@ -11527,6 +11636,106 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 				    ip += 8;
 				    continue;
 				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_i1:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(int32_t*)(localVarBase + __dst)) = il2cpp_array_get(arr, int8_t, (*(int32_t*)(localVarBase + __index)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_u1:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(int32_t*)(localVarBase + __dst)) = il2cpp_array_get(arr, uint8_t, (*(int32_t*)(localVarBase + __index)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_i2:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(int32_t*)(localVarBase + __dst)) = il2cpp_array_get(arr, int16_t, (*(int32_t*)(localVarBase + __index)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_u2:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(int32_t*)(localVarBase + __dst)) = il2cpp_array_get(arr, uint16_t, (*(int32_t*)(localVarBase + __index)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_i4:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(int32_t*)(localVarBase + __dst)) = il2cpp_array_get(arr, int32_t, (*(int32_t*)(localVarBase + __index)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_u4:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(int32_t*)(localVarBase + __dst)) = il2cpp_array_get(arr, uint32_t, (*(int32_t*)(localVarBase + __index)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_i8:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(int64_t*)(localVarBase + __dst)) = il2cpp_array_get(arr, int64_t, (*(int32_t*)(localVarBase + __index)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_u8:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    (*(int64_t*)(localVarBase + __dst)) = il2cpp_array_get(arr, uint64_t, (*(int32_t*)(localVarBase + __index)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_size_12:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    Copy12((void*)(localVarBase + __dst), GET_ARRAY_ELEMENT_ADDRESS(arr, (*(int32_t*)(localVarBase + __index)), 12));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::GetArrayElementUncheckedVarVar_size_16:
+				{
+					uint16_t __dst = *(uint16_t*)(ip + 2);
+					uint16_t __arr = *(uint16_t*)(ip + 4);
+					uint16_t __index = *(uint16_t*)(ip + 6);
+				    Il2CppArray* arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    Copy16((void*)(localVarBase + __dst), GET_ARRAY_ELEMENT_ADDRESS(arr, (*(int32_t*)(localVarBase + __index)), 16));
+				    ip += 8;
+				    continue;
+				}
 				case HiOpcodeEnum::SetArrayElementVarVar_i1:
 				{
 					uint16_t __arr = *(uint16_t*)(ip + 2);
@@ -11673,6 +11882,106 @@ const int32_t kMaxRetValueTypeStackObjectSize = 1024;
 				    ip += 8;
 				    continue;
 				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_i1:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    il2cpp_array_set((*(Il2CppArray**)(localVarBase + __arr)), int8_t, (*(int32_t*)(localVarBase + __index)), (*(int8_t*)(localVarBase + __ele)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_u1:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    il2cpp_array_set((*(Il2CppArray**)(localVarBase + __arr)), uint8_t, (*(int32_t*)(localVarBase + __index)), (*(uint8_t*)(localVarBase + __ele)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_i2:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    il2cpp_array_set((*(Il2CppArray**)(localVarBase + __arr)), int16_t, (*(int32_t*)(localVarBase + __index)), (*(int16_t*)(localVarBase + __ele)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_u2:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    il2cpp_array_set((*(Il2CppArray**)(localVarBase + __arr)), uint16_t, (*(int32_t*)(localVarBase + __index)), (*(uint16_t*)(localVarBase + __ele)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_i4:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    il2cpp_array_set((*(Il2CppArray**)(localVarBase + __arr)), int32_t, (*(int32_t*)(localVarBase + __index)), (*(int32_t*)(localVarBase + __ele)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_u4:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    il2cpp_array_set((*(Il2CppArray**)(localVarBase + __arr)), uint32_t, (*(int32_t*)(localVarBase + __index)), (*(uint32_t*)(localVarBase + __ele)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_i8:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    il2cpp_array_set((*(Il2CppArray**)(localVarBase + __arr)), int64_t, (*(int32_t*)(localVarBase + __index)), (*(int64_t*)(localVarBase + __ele)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_u8:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    il2cpp_array_set((*(Il2CppArray**)(localVarBase + __arr)), uint64_t, (*(int32_t*)(localVarBase + __index)), (*(uint64_t*)(localVarBase + __ele)));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_size_12:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    Copy12(GET_ARRAY_ELEMENT_ADDRESS(_arr, (*(int32_t*)(localVarBase + __index)), 12), (void*)(localVarBase + __ele));
+				    ip += 8;
+				    continue;
+				}
+				case HiOpcodeEnum::SetArrayElementUncheckedVarVar_size_16:
+				{
+					uint16_t __arr = *(uint16_t*)(ip + 2);
+					uint16_t __index = *(uint16_t*)(ip + 4);
+					uint16_t __ele = *(uint16_t*)(ip + 6);
+				    Il2CppArray* _arr = (*(Il2CppArray**)(localVarBase + __arr));
+				    Copy16(GET_ARRAY_ELEMENT_ADDRESS(_arr, (*(int32_t*)(localVarBase + __index)), 16), (void*)(localVarBase + __ele));
+				    ip += 8;
+				    continue;
+				}
 				case HiOpcodeEnum::NewMdArrVarVar_length:
 				{
 					uint16_t __arr = *(uint16_t*)(ip + 2);
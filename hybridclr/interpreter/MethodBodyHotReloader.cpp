@@ -0,0 +1,129 @@
+#include "MethodBodyHotReloader.h"
+
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+#include "vm/Exception.h"
+#include "vm/MetadataLock.h"
+
+#include "../metadata/MetadataModule.h"
+#include "../metadata/InterpreterImage.h"
+#include "../metadata/HotReloadImage.h"
+#include "../metadata/MethodBodyCache.h"
+#include "../MemoryStats.h"
+
+#include "InterpreterModule.h"
+
+namespace hybridclr
+{
+namespace interpreter
+{
+	static bool IsSameAssemblyName(metadata::HotReloadImage* image, const Il2CppAssembly* ass)
+	{
+		metadata::RawImageBase& rawImage = image->GetRawImage();
+		if (rawImage.GetTableRowNum(metadata::TableType::ASSEMBLY) == 0)
+		{
+			return false;
+		}
+		metadata::TbAssembly data = rawImage.ReadAssembly(1);
+		return std::strcmp(rawImage.GetStringFromRawIndex(data.name), ass->aname.name) == 0;
+	}
+
+	metadata::LoadImageErrorCode MethodBodyHotReloader::ReloadMethodBodies(const Il2CppAssembly* ass, const void* dllBytes, uint64_t length, const void* pdbBytes, uint64_t pdbLength)
+	{
+		il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
+
+		if (!dllBytes)
+		{
+			il2cpp::vm::Exception::Raise(il2cpp::vm::Exception::GetArgumentNullException("dllBytes is null"));
+		}
+		if (!metadata::IsInterpreterImage(ass->image))
+		{
+			return metadata::LoadImageErrorCode::HOT_RELOAD_ONLY_SUPPORT_INTERPRETER_ASSEMBLY;
+		}
+		metadata::InterpreterImage* baseImage = metadata::MetadataModule::GetImage(ass->image);
+
+		metadata::HotReloadImage* image = new metadata::HotReloadImage(baseImage);
+		metadata::LoadImageErrorCode err = image->Load((const byte*)CopyBytes(dllBytes, (size_t)length), (size_t)length);
+		if (err != metadata::LoadImageErrorCode::OK)
+		{
+			delete image;
+			return err;
+		}
+		if (pdbBytes)
+		{
+			err = image->LoadPDB(CopyBytes(pdbBytes, (size_t)pdbLength), (size_t)pdbLength);
+			if (err != metadata::LoadImageErrorCode::OK)
+			{
+				delete image;
+				return err;
+			}
+		}
+		if (!IsSameAssemblyName(image, ass) || !image->IsDefinitionCompatible())
+		{
+			delete image;
+			return metadata::LoadImageErrorCode::HOT_RELOAD_INCOMPATIBLE_METADATA;
+		}
+
+		metadata::Image* prevImage = baseImage->GetMethodBodyImage();
+		std::vector<uint32_t> changedRowIndexes;
+		image->ComputeChangedMethods(prevImage, changedRowIndexes);
+		if (changedRowIndexes.empty())
+		{
+			delete image;
+			return metadata::LoadImageErrorCode::OK;
+		}
+
+		std::unordered_set<uint32_t> changedRowIndexSet(changedRowIndexes.begin(), changedRowIndexes.end());
+		auto isChanged = [baseImage, &changedRowIndexSet](const MethodInfo* method)
+		{
+			return metadata::IsInterpreterMethod(method) && metadata::MetadataModule::GetImage(method) == baseImage
+				&& changedRowIndexSet.find(metadata::DecodeTokenRowIndex(method->token)) != changedRowIndexSet.end();
+		};
+
+		// changed methods already transformed, and the methods that inlined one of them
+		std::vector<const MethodInfo*> retransformMethods;
+		for (const MethodInfo* method : InterpreterModule::GetTransformedMethods())
+		{
+			if (method->interpData && isChanged(method))
+			{
+				retransformMethods.push_back(method);
+			}
+		}
+		std::vector<const MethodInfo*> dependentMethods;
+		InterpreterModule::GetDependentMethods(isChanged, dependentMethods);
+		for (const MethodInfo* method : dependentMethods)
+		{
+			if (!isChanged(method))
+			{
+				retransformMethods.push_back(method);
+			}
+		}
+
+		// they are transformed again up front, so a body the new build can't transform
+		// is reported here and the old code keeps running.
+		baseImage->AddHotReloadImage(image);
+		try
+		{
+			InterpreterModule::RetransformMethods(retransformMethods);
+		}
+		catch (Il2CppExceptionWrapper&)
+		{
+			baseImage->RemoveLastHotReloadImage();
+			metadata::MethodBodyCache::RemoveImage(image);
+			delete image;
+			throw;
+		}
+
+		MemoryStats::OnAllocate(MemoryCategory::ImageData, (size_t)length, ass->image);
+		if (pdbBytes)
+		{
+			MemoryStats::OnAllocate(MemoryCategory::DebugInfo, (size_t)pdbLength, ass->image);
+		}
+
+		metadata::MethodBodyCache::RemoveImage(prevImage);
+		return metadata::LoadImageErrorCode::OK;
+	}
+}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../CommonDef.h"
+#include "../metadata/RawImageBase.h"
+
+namespace hybridclr
+{
+namespace interpreter
+{
+	// replaces the method bodies of a loaded interpreter assembly with the ones of a newer build of it.
+	// calls already running finish on the code they entered with, later calls run the new code.
+	// builds that change anything but method bodies are rejected with HOT_RELOAD_INCOMPATIBLE_METADATA.
+	class MethodBodyHotReloader
+	{
+	public:
+		static metadata::LoadImageErrorCode ReloadMethodBodies(const Il2CppAssembly* ass, const void* dllBytes, uint64_t length, const void* pdbBytes, uint64_t pdbLength);
+	};
+}
+}
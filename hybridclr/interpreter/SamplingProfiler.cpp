@@ -0,0 +1,221 @@
+#include "SamplingProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "os/Mutex.h"
+
+#include "Engine.h"
+#include "../metadata/PDBImage.h"
+
+namespace hybridclr
+{
+namespace interpreter
+{
+#if HYBRIDCLR_ENABLE_SAMPLING_PROFILER
+
+	constexpr int32_t kMaxSnapshotRetryCount = 4;
+
+	struct SampledStackFrame
+	{
+		const MethodInfo* method;
+		uint32_t line;
+	};
+
+	static il2cpp::os::FastMutex s_machineStatesLock;
+	static std::vector<MachineState*> s_machineStates;
+
+	// key is the raw bytes of SampledStackFrame array, outermost frame first.
+	static std::unordered_map<std::string, uint64_t> s_samples;
+	static il2cpp::os::FastMutex s_samplesLock;
+
+	static std::thread s_samplingThread;
+	static std::atomic<bool> s_running(false);
+
+	void SamplingProfiler::RegisterMachineState(MachineState* state)
+	{
+		il2cpp::os::FastAutoLock lock(&s_machineStatesLock);
+		s_machineStates.push_back(state);
+	}
+
+	void SamplingProfiler::UnregisterMachineState(MachineState* state)
+	{
+		// sampling thread holds this lock while reading frames, so the MachineState can be freed safely after it returns.
+		il2cpp::os::FastAutoLock lock(&s_machineStatesLock);
+		auto it = std::find(s_machineStates.begin(), s_machineStates.end(), state);
+		if (it != s_machineStates.end())
+		{
+			*it = s_machineStates.back();
+			s_machineStates.pop_back();
+		}
+	}
+
+	static uint32_t GetSampledLine(const SampledFrame& frame)
+	{
+		const InterpMethodInfo* imi = frame.imi;
+		if (!imi || !imi->debugInfo || frame.ip < imi->codes || frame.ip >= imi->codes + imi->codeLength)
+		{
+			return 0;
+		}
+		Il2CppStackFrameInfo stackFrame = {};
+		metadata::PDBImage::SetupStackFrameInfo(imi, frame.ip, stackFrame);
+		return stackFrame.sourceCodeLineNumber;
+	}
+
+	static void SampleAllThreads(std::vector<SampledFrame>& frames, std::string& key)
+	{
+		il2cpp::os::FastAutoLock lock(&s_machineStatesLock);
+		for (MachineState* state : s_machineStates)
+		{
+			bool succ = state->SnapshotFrames(frames);
+			for (int32_t i = 1; !succ && i < kMaxSnapshotRetryCount; i++)
+			{
+				succ = state->SnapshotFrames(frames);
+			}
+			if (!succ || frames.empty())
+			{
+				continue;
+			}
+			key.clear();
+			for (const SampledFrame& frame : frames)
+			{
+				SampledStackFrame ssf;
+				// padding bytes are part of the key
+				std::memset(&ssf, 0, sizeof(ssf));
+				ssf.method = frame.method;
+				ssf.line = GetSampledLine(frame);
+				key.append((const char*)&ssf, sizeof(ssf));
+			}
+			il2cpp::os::FastAutoLock samplesLock(&s_samplesLock);
+			++s_samples[key];
+		}
+	}
+
+	static void SamplingThreadMain(uint32_t intervalMicroseconds)
+	{
+		std::vector<SampledFrame> frames;
+		std::string key;
+		while (s_running.load(std::memory_order_acquire))
+		{
+			SampleAllThreads(frames, key);
+			std::this_thread::sleep_for(std::chrono::microseconds(intervalMicroseconds));
+		}
+	}
+
+	bool SamplingProfiler::Start(uint32_t intervalMicroseconds)
+	{
+		if (intervalMicroseconds == 0 || s_running.exchange(true))
+		{
+			return false;
+		}
+		s_samplingThread = std::thread(SamplingThreadMain, intervalMicroseconds);
+		return true;
+	}
+
+	void SamplingProfiler::Stop()
+	{
+		if (s_running.exchange(false))
+		{
+			s_samplingThread.join();
+		}
+	}
+
+	bool SamplingProfiler::IsRunning()
+	{
+		return s_running.load(std::memory_order_acquire);
+	}
+
+	void SamplingProfiler::Reset()
+	{
+		il2cpp::os::FastAutoLock lock(&s_samplesLock);
+		s_samples.clear();
+	}
+
+	static void AppendFrameName(std::string& name, const SampledStackFrame& frame, bool includeLineNumbers)
+	{
+		const MethodInfo* method = frame.method;
+		const Il2CppClass* klass = method->klass;
+		if (klass->namespaze[0])
+		{
+			name.append(klass->namespaze).push_back('.');
+		}
+		name.append(klass->name).append("::").append(method->name);
+		if (includeLineNumbers && frame.line > 0)
+		{
+			name.push_back(':');
+			name.append(std::to_string(frame.line));
+		}
+	}
+
+	std::string SamplingProfiler::GetFoldedStacks(bool includeLineNumbers)
+	{
+		std::unordered_map<std::string, uint64_t> foldedStacks;
+		{
+			il2cpp::os::FastAutoLock lock(&s_samplesLock);
+			std::string stack;
+			for (auto& e : s_samples)
+			{
+				const SampledStackFrame* frames = (const SampledStackFrame*)e.first.data();
+				size_t frameCount = e.first.size() / sizeof(SampledStackFrame);
+				stack.clear();
+				for (size_t i = 0; i < frameCount; i++)
+				{
+					if (i > 0)
+					{
+						stack.push_back(';');
+					}
+					AppendFrameName(stack, frames[i], includeLineNumbers);
+				}
+				foldedStacks[stack] += e.second;
+			}
+		}
+		std::string result;
+		for (auto& e : foldedStacks)
+		{
+			result.append(e.first).push_back(' ');
+			result.append(std::to_string(e.second)).push_back('\n');
+		}
+		return result;
+	}
+
+#else
+
+	void SamplingProfiler::RegisterMachineState(MachineState* state)
+	{
+	}
+
+	void SamplingProfiler::UnregisterMachineState(MachineState* state)
+	{
+	}
+
+	bool SamplingProfiler::Start(uint32_t intervalMicroseconds)
+	{
+		return false;
+	}
+
+	void SamplingProfiler::Stop()
+	{
+	}
+
+	bool SamplingProfiler::IsRunning()
+	{
+		return false;
+	}
+
+	void SamplingProfiler::Reset()
+	{
+	}
+
+	std::string SamplingProfiler::GetFoldedStacks(bool includeLineNumbers)
+	{
+		return std::string();
+	}
+
+#endif
+}
+}
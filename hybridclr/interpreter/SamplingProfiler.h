@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+
+#include "../CommonDef.h"
+
+namespace hybridclr
+{
+namespace interpreter
+{
+	class MachineState;
+	struct InterpMethodInfo;
+
+	struct SampledFrame
+	{
+		const MethodInfo* method;
+		const InterpMethodInfo* imi;
+		const byte* ip;
+	};
+
+	// periodically samples the interpreter frames of all threads and aggregates them into
+	// flamegraph-compatible folded stacks. requires HYBRIDCLR_ENABLE_SAMPLING_PROFILER.
+	class SamplingProfiler
+	{
+	public:
+		static void RegisterMachineState(MachineState* state);
+		static void UnregisterMachineState(MachineState* state);
+
+		static bool Start(uint32_t intervalMicroseconds);
+		static void Stop();
+		static bool IsRunning();
+		static void Reset();
+
+		// one line per distinct stack: "frame0;frame1;...;frameN count", outermost frame first.
+		// the line number of the innermost frame is approximate: it's the line of its last call, or 0 before it made one.
+		static std::string GetFoldedStacks(bool includeLineNumbers);
+	};
+}
+}
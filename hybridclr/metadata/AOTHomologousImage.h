@@ -32,6 +32,11 @@ namespace metadata
 			return _targetAssembly;
 		}
 
+		const Il2CppImage* GetIl2CppImage() const override
+		{
+			return _targetAssembly->image;
+		}
+
 		void SetTargetAssembly(const Il2CppAssembly* targetAssembly)
 		{
 			_targetAssembly = targetAssembly;
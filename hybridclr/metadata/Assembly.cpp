@@ -19,6 +19,7 @@
 #include "MetadataUtil.h"
 #include "ConsistentAOTHomologousImage.h"
 #include "SuperSetAOTHomologousImage.h"
+#include "../MemoryStats.h"
 
 namespace hybridclr
 {
@@ -104,6 +105,12 @@ namespace metadata
         return ass;
     }
 
+    static void DestroyUnregisteredImage(InterpreterImage* image, uint32_t imageId)
+    {
+        delete image;
+        InterpreterImage::FreeImageIndex(imageId);
+    }
+
     Il2CppAssembly* Assembly::Create(const byte* assemblyData, uint64_t length, const byte* rawSymbolStoreBytes, uint64_t rawSymbolStoreLength)
     {
         il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
@@ -125,9 +132,10 @@ namespace metadata
 
         if (err != LoadImageErrorCode::OK)
         {
+            // nothing references the image before InitBasic, so it and its index can be reclaimed.
+            DestroyUnregisteredImage(image, imageId);
             TEMP_FORMAT(errMsg, "LoadImageErrorCode:%d", (int)err);
             il2cpp::vm::Exception::Raise(il2cpp::vm::Exception::GetBadImageFormatException(errMsg));
-            // when load a bad image, mean a fatal error. we don't clean image on purpose.
         }
 
         if (rawSymbolStoreBytes)
@@ -136,6 +144,7 @@ namespace metadata
             err = image->LoadPDB(rawSymbolStoreBytes, (size_t)rawSymbolStoreLength);
             if (err != LoadImageErrorCode::OK)
             {
+                DestroyUnregisteredImage(image, imageId);
                 TEMP_FORMAT(errMsg, "LoadPDB Error:%d", (int)err);
                 il2cpp::vm::Exception::Raise(il2cpp::vm::Exception::GetBadImageFormatException(errMsg));
             }
@@ -150,6 +159,7 @@ namespace metadata
         {
             if (ass->token)
             {
+                DestroyUnregisteredImage(image, imageId);
                 RaiseExecutionEngineException("reloading placeholder assembly is not supported!");
             }
             image2 = ass->image;
@@ -171,6 +181,12 @@ namespace metadata
         image2->nameNoExt = ass->aname.name;
         image2->assembly = ass;
 
+        MemoryStats::OnAllocate(MemoryCategory::ImageData, (size_t)length, image2);
+        if (rawSymbolStoreBytes)
+        {
+            MemoryStats::OnAllocate(MemoryCategory::DebugInfo, (size_t)rawSymbolStoreLength, image2);
+        }
+
         image->InitRuntimeMetadatas();
 
         il2cpp::vm::MetadataCache::RegisterInterpreterAssembly(ass);
@@ -216,6 +232,7 @@ namespace metadata
         {
             return LoadImageErrorCode::HOMOLOGOUS_ASSEMBLY_HAS_BEEN_LOADED;
         }
+        MemoryStats::OnAllocate(MemoryCategory::ImageData, dllSize, aotAss->image);
         image->InitRuntimeMetadatas();
         AOTHomologousImage::RegisterLocked(image, lock);
         return LoadImageErrorCode::OK;
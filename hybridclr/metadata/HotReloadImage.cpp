@@ -0,0 +1,655 @@
+#include "HotReloadImage.h"
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include "vm/Exception.h"
+
+#include "InterpreterImage.h"
+#include "Opcodes.h"
+
+namespace hybridclr
+{
+namespace metadata
+{
+	// describes a row by its content instead of its index, so the references of two builds of an assembly
+	// compare equal even if the compiler laid out TypeRef, MemberRef or TypeSpec rows differently.
+	// definition rows are described by index, since compatible builds have identical definition tables.
+	class MetadataKeyBuilder
+	{
+	public:
+		MetadataKeyBuilder(RawImageBase& rawImage) : _rawImage(rawImage)
+		{
+
+		}
+
+		const std::string& GetTokenKey(uint32_t token)
+		{
+			auto it = _tokenKeys.find(token);
+			if (it != _tokenKeys.end())
+			{
+				return it->second;
+			}
+			std::string key;
+			AppendTokenKey(DecodeTokenTableType(token), DecodeTokenRowIndex(token), key);
+			return _tokenKeys[token] = key;
+		}
+
+		void AppendTokenKey(TableType tableType, uint32_t rowIndex, std::string& key)
+		{
+			key.push_back((char)tableType);
+			switch (tableType)
+			{
+			case TableType::MODULE:
+			{
+				break;
+			}
+			case TableType::TYPEREF:
+			{
+				TbTypeRef data = _rawImage.ReadTypeRef(rowIndex);
+				TableType scopeType;
+				uint32_t scopeRowIndex;
+				DecodeResolutionScopeCodedIndex(data.resolutionScope, scopeType, scopeRowIndex);
+				AppendTokenKey(scopeType, scopeRowIndex, key);
+				AppendString(data.typeNamespace, key);
+				AppendString(data.typeName, key);
+				break;
+			}
+			case TableType::MODULEREF:
+			{
+				AppendString(_rawImage.ReadModuleRef(rowIndex).name, key);
+				break;
+			}
+			case TableType::ASSEMBLYREF:
+			{
+				AppendString(_rawImage.ReadAssemblyRef(rowIndex).name, key);
+				break;
+			}
+			case TableType::TYPESPEC:
+			{
+				BlobReader reader = _rawImage.GetBlobReaderByRawIndex(_rawImage.ReadTypeSpec(rowIndex).signature);
+				AppendTypeSigKey(reader, key);
+				break;
+			}
+			case TableType::MEMBERREF:
+			{
+				TbMemberRef data = _rawImage.ReadMemberRef(rowIndex);
+				AppendTokenKey(DecodeMemberRefParentCodedIndexTableType(data.classIdx), DecodeMemberRefParentCodedIndexRowIndex(data.classIdx), key);
+				AppendString(data.name, key);
+				AppendSignatureKey(data.signature, key);
+				break;
+			}
+			case TableType::METHODSPEC:
+			{
+				TbMethodSpec data = _rawImage.ReadMethodSpec(rowIndex);
+				AppendTokenKey(DecodeMethodDefOrRefCodedIndexTableType(data.method), DecodeMethodDefOrRefCodedIndexRowIndex(data.method), key);
+				AppendSignatureKey(data.instantiation, key);
+				break;
+			}
+			case TableType::STANDALONESIG:
+			{
+				AppendSignatureKey(_rawImage.ReadStandAloneSig(rowIndex).signature, key);
+				break;
+			}
+			default:
+			{
+				AppendUint32(rowIndex, key);
+				break;
+			}
+			}
+		}
+
+		void AppendTypeDefOrRefOrSpecKey(uint32_t codedIndex, std::string& key)
+		{
+			if (codedIndex == 0)
+			{
+				key.push_back('\0');
+				return;
+			}
+			AppendTokenKey(DecodeTypeDefOrRefOrSpecCodedIndexTableType(codedIndex), DecodeTypeDefOrRefOrSpecCodedIndexRowIndex(codedIndex), key);
+		}
+
+		void AppendMethodDefOrRefKey(uint32_t codedIndex, std::string& key)
+		{
+			AppendTokenKey(DecodeMethodDefOrRefCodedIndexTableType(codedIndex), DecodeMethodDefOrRefCodedIndexRowIndex(codedIndex), key);
+		}
+
+		// field, method, property, local var and method instantiation signatures
+		void AppendSignatureKey(uint32_t blobIndex, std::string& key)
+		{
+			BlobReader reader = _rawImage.GetBlobReaderByRawIndex(blobIndex);
+			uint8_t rawSigFlags = reader.ReadByte();
+			key.push_back((char)rawSigFlags);
+			uint8_t sigType = rawSigFlags & kSigMask;
+			switch (sigType)
+			{
+			case (uint8_t)SigType::FIELD:
+			{
+				AppendTypeSigKey(reader, key);
+				break;
+			}
+			case (uint8_t)SigType::LOCAL_VAR:
+			case 0x0A: // GENERICINST of MethodSpec
+			{
+				uint32_t count = AppendCompressedUint32(reader, key);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					AppendTypeSigKey(reader, key);
+				}
+				break;
+			}
+			case (uint8_t)SigType::PROPERTY_NOT_THIS:
+			{
+				uint32_t paramCount = AppendCompressedUint32(reader, key);
+				for (uint32_t i = 0; i <= paramCount; i++)
+				{
+					AppendTypeSigKey(reader, key);
+				}
+				break;
+			}
+			default:
+			{
+				AppendMethodSigKey(rawSigFlags, reader, key);
+				break;
+			}
+			}
+		}
+
+		void AppendTypeSigKey(BlobReader& reader, std::string& key)
+		{
+			uint8_t etype = reader.ReadByte();
+			key.push_back((char)etype);
+			switch (etype)
+			{
+			case IL2CPP_TYPE_CMOD_REQD:
+			case IL2CPP_TYPE_CMOD_OPT:
+			{
+				AppendTypeDefOrRefOrSpecKey(reader.ReadCompressedUint32(), key);
+				AppendTypeSigKey(reader, key);
+				break;
+			}
+			case IL2CPP_TYPE_PTR:
+			case IL2CPP_TYPE_BYREF:
+			case IL2CPP_TYPE_SZARRAY:
+			case IL2CPP_TYPE_PINNED:
+			{
+				AppendTypeSigKey(reader, key);
+				break;
+			}
+			case IL2CPP_TYPE_VALUETYPE:
+			case IL2CPP_TYPE_CLASS:
+			{
+				AppendTypeDefOrRefOrSpecKey(reader.ReadCompressedUint32(), key);
+				break;
+			}
+			case IL2CPP_TYPE_VAR:
+			case IL2CPP_TYPE_MVAR:
+			{
+				AppendCompressedUint32(reader, key);
+				break;
+			}
+			case IL2CPP_TYPE_ARRAY:
+			{
+				AppendTypeSigKey(reader, key);
+				AppendCompressedUint32(reader, key); // rank
+				uint32_t sizeCount = AppendCompressedUint32(reader, key);
+				for (uint32_t i = 0; i < sizeCount; i++)
+				{
+					AppendCompressedUint32(reader, key);
+				}
+				uint32_t lowerBoundCount = AppendCompressedUint32(reader, key);
+				for (uint32_t i = 0; i < lowerBoundCount; i++)
+				{
+					AppendCompressedUint32(reader, key);
+				}
+				break;
+			}
+			case IL2CPP_TYPE_GENERICINST:
+			{
+				AppendTypeSigKey(reader, key);
+				uint32_t argCount = AppendCompressedUint32(reader, key);
+				for (uint32_t i = 0; i < argCount; i++)
+				{
+					AppendTypeSigKey(reader, key);
+				}
+				break;
+			}
+			case IL2CPP_TYPE_FNPTR:
+			{
+				uint8_t rawSigFlags = reader.ReadByte();
+				key.push_back((char)rawSigFlags);
+				AppendMethodSigKey(rawSigFlags, reader, key);
+				break;
+			}
+			default:
+			{
+				// primitive types, string, object, typedbyref and sentinel have no operand
+				break;
+			}
+			}
+		}
+
+		void AppendUserStringKey(uint32_t index, std::string& key)
+		{
+			BlobReader reader = _rawImage.GetUserStringBlobByRawIndex(index);
+			key.append((const char*)reader.GetData(), reader.GetLength());
+		}
+	private:
+
+		void AppendMethodSigKey(uint8_t rawSigFlags, BlobReader& reader, std::string& key)
+		{
+			if (rawSigFlags & (uint8_t)SigType::GENERIC)
+			{
+				AppendCompressedUint32(reader, key);
+			}
+			uint32_t paramCount = AppendCompressedUint32(reader, key);
+			// return type, then params. a vararg sentinel is a standalone element and is covered by AppendTypeSigKey
+			for (uint32_t i = 0; i <= paramCount; i++)
+			{
+				if (reader.PeekByte() == (uint8_t)SigType::SENTINEL)
+				{
+					key.push_back((char)reader.ReadByte());
+				}
+				AppendTypeSigKey(reader, key);
+			}
+		}
+
+		uint32_t AppendCompressedUint32(BlobReader& reader, std::string& key)
+		{
+			uint32_t value = reader.ReadCompressedUint32();
+			AppendUint32(value, key);
+			return value;
+		}
+
+		void AppendUint32(uint32_t value, std::string& key)
+		{
+			key.append((const char*)&value, sizeof(value));
+		}
+
+		void AppendString(uint32_t stringIndex, std::string& key)
+		{
+			key.append(_rawImage.GetStringFromRawIndex(stringIndex));
+			key.push_back('\0');
+		}
+
+		RawImageBase& _rawImage;
+		std::unordered_map<uint32_t, std::string> _tokenKeys;
+	};
+
+	LoadImageErrorCode HotReloadImage::Load(const byte* imageData, size_t length)
+	{
+		LoadImageErrorCode err = InitRawImage(imageData, length);
+		if (err != LoadImageErrorCode::OK)
+		{
+			return err;
+		}
+		err = _rawImage->Load(imageData, length);
+		if (err != LoadImageErrorCode::OK)
+		{
+			delete _rawImage;
+			_rawImage = nullptr;
+			return err;
+		}
+		return LoadImageErrorCode::OK;
+	}
+
+	static bool IsSameString(const RawImageBase& a, const RawImageBase& b, uint32_t aIndex, uint32_t bIndex)
+	{
+		return std::strcmp(a.GetStringFromRawIndex(aIndex), b.GetStringFromRawIndex(bIndex)) == 0;
+	}
+
+	static bool IsSameSignature(MetadataKeyBuilder& a, MetadataKeyBuilder& b, uint32_t aBlobIndex, uint32_t bBlobIndex)
+	{
+		std::string aKey;
+		std::string bKey;
+		a.AppendSignatureKey(aBlobIndex, aKey);
+		b.AppendSignatureKey(bBlobIndex, bKey);
+		return aKey == bKey;
+	}
+
+	static bool IsSameTypeDefOrRefOrSpec(MetadataKeyBuilder& a, MetadataKeyBuilder& b, uint32_t aCodedIndex, uint32_t bCodedIndex)
+	{
+		std::string aKey;
+		std::string bKey;
+		a.AppendTypeDefOrRefOrSpecKey(aCodedIndex, aKey);
+		b.AppendTypeDefOrRefOrSpecKey(bCodedIndex, bKey);
+		return aKey == bKey;
+	}
+
+	static bool IsSameMethodDefOrRef(MetadataKeyBuilder& a, MetadataKeyBuilder& b, uint32_t aCodedIndex, uint32_t bCodedIndex)
+	{
+		std::string aKey;
+		std::string bKey;
+		a.AppendMethodDefOrRefKey(aCodedIndex, aKey);
+		b.AppendMethodDefOrRefKey(bCodedIndex, bKey);
+		return aKey == bKey;
+	}
+
+	bool HotReloadImage::IsDefinitionCompatible() const
+	{
+		RawImageBase& oldRaw = _baseImage->GetRawImage();
+		RawImageBase& newRaw = *_rawImage;
+		MetadataKeyBuilder oldKeys(oldRaw);
+		MetadataKeyBuilder newKeys(newRaw);
+
+		// the definition and layout tables must match row by row. the tables below only need the same shape,
+		// their contents (custom attributes, constants, properties, events, pinvoke and rva data) keep coming from the base image.
+		static const TableType kSameRowCountTables[] =
+		{
+			TableType::TYPEDEF, TableType::FIELD, TableType::METHOD, TableType::PARAM, TableType::INTERFACEIMPL,
+			TableType::CONSTANT, TableType::CUSTOMATTRIBUTE, TableType::CLASSLAYOUT, TableType::FIELDLAYOUT,
+			TableType::EVENTMAP, TableType::EVENT, TableType::PROPERTYMAP, TableType::PROPERTY, TableType::METHODSEMANTICS,
+			TableType::METHODIMPL, TableType::IMPLMAP, TableType::FIELDRVA, TableType::NESTEDCLASS, TableType::GENERICPARAM,
+			TableType::GENERICPARAMCONSTRAINT,
+		};
+		for (TableType tableType : kSameRowCountTables)
+		{
+			if (oldRaw.GetTableRowNum(tableType) != newRaw.GetTableRowNum(tableType))
+			{
+				return false;
+			}
+		}
+
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::TYPEDEF); i <= n; i++)
+		{
+			TbTypeDef a = oldRaw.ReadTypeDef(i);
+			TbTypeDef b = newRaw.ReadTypeDef(i);
+			if (a.flags != b.flags || a.fieldList != b.fieldList || a.methodList != b.methodList
+				|| !IsSameString(oldRaw, newRaw, a.typeNamespace, b.typeNamespace) || !IsSameString(oldRaw, newRaw, a.typeName, b.typeName)
+				|| !IsSameTypeDefOrRefOrSpec(oldKeys, newKeys, a.extends, b.extends))
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::FIELD); i <= n; i++)
+		{
+			TbField a = oldRaw.ReadField(i);
+			TbField b = newRaw.ReadField(i);
+			// names are compared too, because the compiler names static array initializer data after its content
+			if (a.flags != b.flags || !IsSameString(oldRaw, newRaw, a.name, b.name) || !IsSameSignature(oldKeys, newKeys, a.signature, b.signature))
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::METHOD); i <= n; i++)
+		{
+			TbMethod a = oldRaw.ReadMethod(i);
+			TbMethod b = newRaw.ReadMethod(i);
+			if (a.flags != b.flags || a.implFlags != b.implFlags || a.paramList != b.paramList || (a.rva == 0) != (b.rva == 0)
+				|| !IsSameString(oldRaw, newRaw, a.name, b.name) || !IsSameSignature(oldKeys, newKeys, a.signature, b.signature))
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::PARAM); i <= n; i++)
+		{
+			TbParam a = oldRaw.ReadParam(i);
+			TbParam b = newRaw.ReadParam(i);
+			if (a.flags != b.flags || a.sequence != b.sequence)
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::INTERFACEIMPL); i <= n; i++)
+		{
+			TbInterfaceImpl a = oldRaw.ReadInterfaceImpl(i);
+			TbInterfaceImpl b = newRaw.ReadInterfaceImpl(i);
+			if (a.classIdx != b.classIdx || !IsSameTypeDefOrRefOrSpec(oldKeys, newKeys, a.interfaceIdx, b.interfaceIdx))
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::CLASSLAYOUT); i <= n; i++)
+		{
+			TbClassLayout a = oldRaw.ReadClassLayout(i);
+			TbClassLayout b = newRaw.ReadClassLayout(i);
+			if (a.packingSize != b.packingSize || a.classSize != b.classSize || a.parent != b.parent)
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::FIELDLAYOUT); i <= n; i++)
+		{
+			TbFieldLayout a = oldRaw.ReadFieldLayout(i);
+			TbFieldLayout b = newRaw.ReadFieldLayout(i);
+			if (a.offset != b.offset || a.field != b.field)
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::METHODIMPL); i <= n; i++)
+		{
+			TbMethodImpl a = oldRaw.ReadMethodImpl(i);
+			TbMethodImpl b = newRaw.ReadMethodImpl(i);
+			if (a.classIdx != b.classIdx || !IsSameMethodDefOrRef(oldKeys, newKeys, a.methodBody, b.methodBody)
+				|| !IsSameMethodDefOrRef(oldKeys, newKeys, a.methodDeclaration, b.methodDeclaration))
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::NESTEDCLASS); i <= n; i++)
+		{
+			TbNestedClass a = oldRaw.ReadNestedClass(i);
+			TbNestedClass b = newRaw.ReadNestedClass(i);
+			if (a.nestedClass != b.nestedClass || a.enclosingClass != b.enclosingClass)
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::GENERICPARAM); i <= n; i++)
+		{
+			TbGenericParam a = oldRaw.ReadGenericParam(i);
+			TbGenericParam b = newRaw.ReadGenericParam(i);
+			if (a.number != b.number || a.flags != b.flags || a.owner != b.owner)
+			{
+				return false;
+			}
+		}
+		for (uint32_t i = 1, n = oldRaw.GetTableRowNum(TableType::GENERICPARAMCONSTRAINT); i <= n; i++)
+		{
+			TbGenericParamConstraint a = oldRaw.ReadGenericParamConstraint(i);
+			TbGenericParamConstraint b = newRaw.ReadGenericParamConstraint(i);
+			if (a.owner != b.owner || !IsSameTypeDefOrRefOrSpec(oldKeys, newKeys, a.constraint, b.constraint))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// false if the instruction at ip, operands included, doesn't fit before end
+	static bool TryGetOpCodeSize(const byte* ip, const OpCodeInfo* oc, const byte* end, uint32_t& opCodeSize)
+	{
+		uint64_t size;
+		if (oc->inlineType == ArgType::Switch)
+		{
+			if (end - ip < 5)
+			{
+				return false;
+			}
+			size = (uint64_t)(uint32_t)GetI4LittleEndian(ip + 1) * 4 + 5;
+		}
+		else
+		{
+			size = GetOpCodeSize(ip, oc);
+		}
+		if (size > (uint64_t)(end - ip))
+		{
+			return false;
+		}
+		opCodeSize = (uint32_t)size;
+		return true;
+	}
+
+	static bool IsSameILCode(MetadataKeyBuilder& oldKeys, MetadataKeyBuilder& newKeys, const MethodBody& a, const MethodBody& b)
+	{
+		const byte* aIp = a.ilcodes;
+		const byte* aEnd = a.ilcodes + a.codeSize;
+		const byte* bIp = b.ilcodes;
+		const byte* bEnd = b.ilcodes + b.codeSize;
+		while (aIp < aEnd)
+		{
+			const OpCodeInfo* aOc = DecodeOpCodeInfo(aIp, aEnd);
+			const OpCodeInfo* bOc = DecodeOpCodeInfo(bIp, bEnd);
+			if (!aOc || aOc != bOc)
+			{
+				return false;
+			}
+			uint32_t opCodeSize;
+			uint32_t bOpCodeSize;
+			if (!TryGetOpCodeSize(aIp, aOc, aEnd, opCodeSize) || !TryGetOpCodeSize(bIp, bOc, bEnd, bOpCodeSize) || bOpCodeSize != opCodeSize)
+			{
+				return false;
+			}
+			bool isTokenOperand = aOc->inlineType == ArgType::Data && aOc->inlineParam == 4
+				&& aOc->id != OpcodeEnum::LDC_I4 && aOc->id != OpcodeEnum::LDC_R4;
+			if (aOc->id == OpcodeEnum::LDSTR)
+			{
+				std::string aStr;
+				std::string bStr;
+				oldKeys.AppendUserStringKey(DecodeTokenRowIndex(GetI4LittleEndian(aIp + 1)), aStr);
+				newKeys.AppendUserStringKey(DecodeTokenRowIndex(GetI4LittleEndian(bIp + 1)), bStr);
+				if (aStr != bStr)
+				{
+					return false;
+				}
+			}
+			else if (isTokenOperand)
+			{
+				if (oldKeys.GetTokenKey((uint32_t)GetI4LittleEndian(aIp + 1)) != newKeys.GetTokenKey((uint32_t)GetI4LittleEndian(bIp + 1)))
+				{
+					return false;
+				}
+			}
+			else if (std::memcmp(aIp, bIp, opCodeSize) != 0)
+			{
+				return false;
+			}
+			aIp += opCodeSize;
+			bIp += opCodeSize;
+		}
+		return bIp == bEnd;
+	}
+
+	static bool IsSameMethodBody(const Image* oldImage, const Image* newImage, MetadataKeyBuilder& oldKeys, MetadataKeyBuilder& newKeys, uint32_t rowIndex)
+	{
+		MethodBody a = {};
+		MethodBody b = {};
+		uint32_t aLocalVarSigToken = oldImage->ReadMethodBodyWithoutLocalVars(oldImage->GetRawImage().ReadMethod(rowIndex), a);
+		uint32_t bLocalVarSigToken = newImage->ReadMethodBodyWithoutLocalVars(newImage->GetRawImage().ReadMethod(rowIndex), b);
+		if (a.ilcodes == nullptr || b.ilcodes == nullptr)
+		{
+			return a.ilcodes == b.ilcodes;
+		}
+		if (a.flags != b.flags || a.codeSize != b.codeSize || a.maxStack != b.maxStack
+			|| a.exceptionClauses.size() != b.exceptionClauses.size() || (aLocalVarSigToken == 0) != (bLocalVarSigToken == 0))
+		{
+			return false;
+		}
+		if (aLocalVarSigToken && oldKeys.GetTokenKey(aLocalVarSigToken) != newKeys.GetTokenKey(bLocalVarSigToken))
+		{
+			return false;
+		}
+		for (size_t i = 0; i < a.exceptionClauses.size(); i++)
+		{
+			const ExceptionClause& ea = a.exceptionClauses[i];
+			const ExceptionClause& eb = b.exceptionClauses[i];
+			if (ea.flags != eb.flags || ea.tryOffset != eb.tryOffset || ea.tryLength != eb.tryLength
+				|| ea.handlerOffsets != eb.handlerOffsets || ea.handlerLength != eb.handlerLength)
+			{
+				return false;
+			}
+			bool same = ea.flags == CorILExceptionClauseType::Exception
+				? oldKeys.GetTokenKey(ea.classTokenOrFilterOffset) == newKeys.GetTokenKey(eb.classTokenOrFilterOffset)
+				: ea.classTokenOrFilterOffset == eb.classTokenOrFilterOffset;
+			if (!same)
+			{
+				return false;
+			}
+		}
+		return IsSameILCode(oldKeys, newKeys, a, b);
+	}
+
+	void HotReloadImage::ComputeChangedMethods(const Image* prevImage, std::vector<uint32_t>& changedMethodRowIndexes) const
+	{
+		MetadataKeyBuilder oldKeys(prevImage->GetRawImage());
+		MetadataKeyBuilder newKeys(*_rawImage);
+		for (uint32_t i = 1, n = _rawImage->GetTableRowNum(TableType::METHOD); i <= n; i++)
+		{
+			if (!IsSameMethodBody(prevImage, this, oldKeys, newKeys, i))
+			{
+				changedMethodRowIndexes.push_back(i);
+			}
+		}
+	}
+
+	const Il2CppType* HotReloadImage::GetModuleIl2CppType(uint32_t moduleRowIndex, uint32_t typeNamespace, uint32_t typeName, bool raiseExceptionIfNotFound)
+	{
+		IL2CPP_ASSERT(moduleRowIndex == 1);
+		// typedef rows are identical to the base image, so the row found here is also the row of the base type
+		for (uint32_t i = 1, n = _rawImage->GetTableRowNum(TableType::TYPEDEF); i <= n; i++)
+		{
+			TbTypeDef data = _rawImage->ReadTypeDef(i);
+			if (data.typeNamespace == typeNamespace && data.typeName == typeName)
+			{
+				return _baseImage->GetIl2CppTypeFromRawTypeDefIndex(i - 1);
+			}
+		}
+		if (!raiseExceptionIfNotFound)
+		{
+			return nullptr;
+		}
+		const char* typeNameStr = _rawImage->GetStringFromRawIndex(typeName);
+		const char* typeNamespaceStr = _rawImage->GetStringFromRawIndex(typeNamespace);
+		il2cpp::vm::Exception::Raise(il2cpp::vm::Exception::GetTypeLoadException(
+			CStringToStringView(typeNamespaceStr),
+			CStringToStringView(typeNameStr),
+			CStringToStringView(GetIl2CppImage()->nameNoExt)));
+		return nullptr;
+	}
+
+	const Il2CppType* HotReloadImage::GetIl2CppTypeFromRawTypeDefIndex(uint32_t index)
+	{
+		return _baseImage->GetIl2CppTypeFromRawTypeDefIndex(index);
+	}
+
+	Il2CppGenericContainer* HotReloadImage::GetGenericContainerByRawIndex(uint32_t index)
+	{
+		return _baseImage->GetGenericContainerByRawIndex(index);
+	}
+
+	Il2CppGenericContainer* HotReloadImage::GetGenericContainerByTypeDefRawIndex(int32_t typeDefIndex)
+	{
+		return _baseImage->GetGenericContainerByTypeDefRawIndex(typeDefIndex);
+	}
+
+	const Il2CppMethodDefinition* HotReloadImage::GetMethodDefinitionFromRawIndex(uint32_t index)
+	{
+		return _baseImage->GetMethodDefinitionFromRawIndex(index);
+	}
+
+	MethodBody* HotReloadImage::GetMethodBody(uint32_t token)
+	{
+		IL2CPP_ASSERT(DecodeTokenTableType(token) == TableType::METHOD);
+		uint32_t rowIndex = DecodeTokenRowIndex(token);
+		IL2CPP_ASSERT(rowIndex > 0 && rowIndex <= _rawImage->GetTableRowNum(TableType::METHOD));
+
+		const Il2CppMethodDefinition* methodDef = _baseImage->GetMethodDefinitionFromRawIndex(rowIndex - 1);
+		TbMethod methodData = _rawImage->ReadMethod(rowIndex);
+		MethodBody* resultMethodBody = new (HYBRIDCLR_MALLOC_ZERO(sizeof(MethodBody))) MethodBody();
+		ReadMethodBody(*methodDef, methodData, *resultMethodBody);
+		return resultMethodBody;
+	}
+
+	const Il2CppImage* HotReloadImage::GetIl2CppImage() const
+	{
+		return _baseImage->GetIl2CppImage();
+	}
+
+	void HotReloadImage::ReadFieldRefInfoFromFieldDefToken(uint32_t rowIndex, FieldRefInfo& ret)
+	{
+		_baseImage->ReadFieldRefInfoFromFieldDefToken(rowIndex, ret);
+	}
+}
+}
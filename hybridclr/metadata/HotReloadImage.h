@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Image.h"
+
+namespace hybridclr
+{
+namespace metadata
+{
+	class InterpreterImage;
+
+	// a newer build of a loaded interpreter assembly in which only method bodies changed.
+	// definitions (types, fields, method signatures, layouts) must match the loaded image row by row, so they are
+	// resolved through it and existing classes and MethodInfos stay valid. the new build supplies method bodies,
+	// user strings, references used by the bodies and debug info.
+	class HotReloadImage : public Image
+	{
+	public:
+		HotReloadImage(InterpreterImage* baseImage) : _baseImage(baseImage)
+		{
+
+		}
+
+		InterpreterImage* GetBaseImage() const
+		{
+			return _baseImage;
+		}
+
+		LoadImageErrorCode Load(const byte* imageData, size_t length);
+
+		// false if anything but method bodies differs from the base image
+		bool IsDefinitionCompatible() const;
+
+		// row indexes of the methods whose body differs from the one in prevImage, the base image or an earlier patch
+		void ComputeChangedMethods(const Image* prevImage, std::vector<uint32_t>& changedMethodRowIndexes) const;
+
+		const Il2CppType* GetModuleIl2CppType(uint32_t moduleRowIndex, uint32_t typeNamespace, uint32_t typeName, bool raiseExceptionIfNotFound) override;
+		const Il2CppType* GetIl2CppTypeFromRawTypeDefIndex(uint32_t index) override;
+		Il2CppGenericContainer* GetGenericContainerByRawIndex(uint32_t index) override;
+		Il2CppGenericContainer* GetGenericContainerByTypeDefRawIndex(int32_t typeDefIndex) override;
+		const Il2CppMethodDefinition* GetMethodDefinitionFromRawIndex(uint32_t index) override;
+		MethodBody* GetMethodBody(uint32_t token) override;
+		const Il2CppImage* GetIl2CppImage() const override;
+		void ReadFieldRefInfoFromFieldDefToken(uint32_t rowIndex, FieldRefInfo& ret) override;
+
+		void InitRuntimeMetadatas() override
+		{
+
+		}
+	private:
+		InterpreterImage* const _baseImage;
+	};
+}
+}
@@ -142,14 +142,18 @@ namespace metadata
 
 #pragma region type
 
-    const Il2CppType* Image::ReadArrayType(BlobReader& reader, const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer)
+    const Il2CppType* Image::ReadArrayType(BlobReader& reader, const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer, bool raiseExceptionIfNotFound)
     {
+        const Il2CppType* eleType = ReadType(reader, klassGenericContainer, methodGenericContainer, raiseExceptionIfNotFound);
+        if (!eleType)
+        {
+            return nullptr;
+        }
         Il2CppType* arrType = MetadataMallocT<Il2CppType>();;
         arrType->type = IL2CPP_TYPE_ARRAY;
         Il2CppArrayType& type = *MetadataMallocT<Il2CppArrayType>();
         arrType->data.array = &type;
 
-        const Il2CppType* eleType = ReadType(reader, klassGenericContainer, methodGenericContainer);
         type.etype = eleType;
         type.rank = reader.ReadCompressedUint32();
         type.numsizes = reader.ReadCompressedUint32();
@@ -181,10 +185,10 @@ namespace metadata
         return arrType;
     }
 
-    const Il2CppGenericClass* Image::ReadGenericClass(BlobReader& reader, const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer)
+    const Il2CppGenericClass* Image::ReadGenericClass(BlobReader& reader, const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer, bool raiseExceptionIfNotFound)
     {
-        const Il2CppType* genericBase = ReadType(reader, klassGenericContainer, methodGenericContainer);
-        IL2CPP_ASSERT(genericBase->type == IL2CPP_TYPE_CLASS || genericBase->type == IL2CPP_TYPE_VALUETYPE);
+        const Il2CppType* genericBase = ReadType(reader, klassGenericContainer, methodGenericContainer, raiseExceptionIfNotFound);
+        IL2CPP_ASSERT(!genericBase || genericBase->type == IL2CPP_TYPE_CLASS || genericBase->type == IL2CPP_TYPE_VALUETYPE);
 
         uint32_t argc = reader.ReadCompressedUint32();
         IL2CPP_ASSERT(argc > 0 && argc <= 32);
@@ -192,14 +196,23 @@ namespace metadata
         //const Il2CppType** types = (const Il2CppType**)alloca(argc * sizeof(const Il2CppType*));
         for (uint32_t i = 0; i < argc; i++)
         {
-            types[i] = ReadType(reader, klassGenericContainer, methodGenericContainer);
+            types[i] = ReadType(reader, klassGenericContainer, methodGenericContainer, raiseExceptionIfNotFound);
+            // keep reading the remaining args so the reader ends after this signature
+            if (!types[i])
+            {
+                genericBase = nullptr;
+            }
+        }
+        if (!genericBase)
+        {
+            return nullptr;
         }
         const Il2CppGenericInst* genericInst = il2cpp::vm::MetadataCache::GetGenericInst(types, argc);
 
         return il2cpp::metadata::GenericMetadata::GetGenericClass(genericBase, genericInst);
     }
 
-    const Il2CppType* Image::ReadType(BlobReader& reader, const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer)
+    const Il2CppType* Image::ReadType(BlobReader& reader, const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer, bool raiseExceptionIfNotFound)
     {
         Il2CppType type = {};
         const Il2CppType* underlyingType = nullptr;
@@ -236,7 +249,11 @@ namespace metadata
         case IL2CPP_TYPE_PTR:
         {
             //SET_IL2CPPTYPE_VALUE_TYPE(type, 1);
-            type.data.type = ReadType(reader, klassGenericContainer, methodGenericContainer);
+            type.data.type = ReadType(reader, klassGenericContainer, methodGenericContainer, raiseExceptionIfNotFound);
+            if (!type.data.type)
+            {
+                return nullptr;
+            }
             //SET_IL2CPPTYPE_VALUE_TYPE(type, 1);
             break;
         }
@@ -251,17 +268,29 @@ namespace metadata
         case IL2CPP_TYPE_CLASS:
         {
             uint32_t codedIndex = reader.ReadCompressedUint32(); // 低2位为type, 高位为index
-            underlyingType = ReadTypeFromToken(klassGenericContainer, methodGenericContainer, DecodeTypeDefOrRefOrSpecCodedIndexTableType(codedIndex), DecodeTypeDefOrRefOrSpecCodedIndexRowIndex(codedIndex));
+            underlyingType = ReadTypeFromToken(klassGenericContainer, methodGenericContainer, DecodeTypeDefOrRefOrSpecCodedIndexTableType(codedIndex), DecodeTypeDefOrRefOrSpecCodedIndexRowIndex(codedIndex), raiseExceptionIfNotFound);
+            if (!underlyingType)
+            {
+                return nullptr;
+            }
             break;
         }
         case IL2CPP_TYPE_ARRAY:
         {
-            underlyingType = ReadArrayType(reader, klassGenericContainer, methodGenericContainer);
+            underlyingType = ReadArrayType(reader, klassGenericContainer, methodGenericContainer, raiseExceptionIfNotFound);
+            if (!underlyingType)
+            {
+                return nullptr;
+            }
             break;
         }
         case IL2CPP_TYPE_GENERICINST:
         {
-            const Il2CppGenericClass* genericClass = ReadGenericClass(reader, klassGenericContainer, methodGenericContainer);
+            const Il2CppGenericClass* genericClass = ReadGenericClass(reader, klassGenericContainer, methodGenericContainer, raiseExceptionIfNotFound);
+            if (!genericClass)
+            {
+                return nullptr;
+            }
             type.data.generic_class = const_cast<Il2CppGenericClass*>(genericClass);
             COPY_IL2CPPTYPE_VALUE_TYPE_FLAG(type, *genericClass->type);
             break;
@@ -285,7 +314,11 @@ namespace metadata
         }
         case IL2CPP_TYPE_SZARRAY:
         {
-            type.data.type = ReadType(reader, klassGenericContainer, methodGenericContainer);
+            type.data.type = ReadType(reader, klassGenericContainer, methodGenericContainer, raiseExceptionIfNotFound);
+            if (!type.data.type)
+            {
+                return nullptr;
+            }
             break;
         }
         case IL2CPP_TYPE_VAR:
@@ -324,7 +357,11 @@ namespace metadata
         {
             ++type.num_mods;
             uint32_t encodeToken = reader.ReadCompressedUint32();
-            const Il2CppType* modType = ReadTypeFromToken(nullptr, nullptr, DecodeTypeDefOrRefOrSpecCodedIndexTableType(encodeToken), DecodeTypeDefOrRefOrSpecCodedIndexRowIndex(encodeToken));
+            const Il2CppType* modType = ReadTypeFromToken(nullptr, nullptr, DecodeTypeDefOrRefOrSpecCodedIndexTableType(encodeToken), DecodeTypeDefOrRefOrSpecCodedIndexRowIndex(encodeToken), raiseExceptionIfNotFound);
+            if (!modType)
+            {
+                return nullptr;
+            }
             if (modType->type != IL2CPP_TYPE_CLASS && modType->type != IL2CPP_TYPE_VALUETYPE)
             {
                 goto readAgain;
@@ -394,7 +431,7 @@ namespace metadata
         return MetadataPool::GetPooledIl2CppType(type);
     }
 
-    const Il2CppType* Image::ReadTypeFromResolutionScope(uint32_t scope, uint32_t typeNamespace, uint32_t typeName)
+    const Il2CppType* Image::ReadTypeFromResolutionScope(uint32_t scope, uint32_t typeNamespace, uint32_t typeName, bool raiseExceptionIfNotFound)
     {
         TableType tokenType;
         uint32_t rawIndex;
@@ -403,21 +440,29 @@ namespace metadata
         {
         case TableType::MODULE:
         {
-            return GetModuleIl2CppType(rawIndex, typeNamespace, typeName, true);
+            return GetModuleIl2CppType(rawIndex, typeNamespace, typeName, raiseExceptionIfNotFound);
         }
         case TableType::MODULEREF:
         {
+            if (!raiseExceptionIfNotFound)
+            {
+                return nullptr;
+            }
             RaiseNotSupportedException("Image::ReadTypeFromResolutionScope not support ResolutionScore.MODULEREF");
             break;
         }
         case TableType::ASSEMBLYREF:
         {
             TbAssemblyRef assRef = _rawImage->ReadAssemblyRef(rawIndex);
-            return GetIl2CppType(rawIndex, typeNamespace, typeName, true);
+            return GetIl2CppType(rawIndex, typeNamespace, typeName, raiseExceptionIfNotFound);
         }
         case TableType::TYPEREF:
         {
-            const Il2CppType* enClosingType = ReadTypeFromTypeRef(rawIndex);
+            const Il2CppType* enClosingType = ReadTypeFromTypeRef(rawIndex, raiseExceptionIfNotFound);
+            if (!enClosingType)
+            {
+                return nullptr;
+            }
             IL2CPP_ASSERT(typeNamespace == 0);
             const char* name = _rawImage->GetStringFromRawIndex(typeName);
 
@@ -425,6 +470,10 @@ namespace metadata
             Il2CppMetadataTypeHandle enclosingTypeDef = enClosingType->data.typeHandle;
             if (!enclosingTypeDef)
             {
+                if (!raiseExceptionIfNotFound)
+                {
+                    return nullptr;
+                }
                 TEMP_FORMAT(errMsg, "Image::ReadTypeFromResolutionScope ReadTypeFromResolutionScope.TYPEREF enclosingType:%s", name);
                 RaiseExecutionEngineException(errMsg);
             }
@@ -438,6 +487,10 @@ namespace metadata
                 }
             }
 
+            if (!raiseExceptionIfNotFound)
+            {
+                return nullptr;
+            }
             std::string enclosingTypeName = GetKlassCStringFullName(enClosingType);
             TEMP_FORMAT(errMsg, "Image::ReadTypeFromResolutionScope ReadTypeFromResolutionScope.TYPEREF fail. type:%s.%s", enclosingTypeName.c_str(), name);
             RaiseExecutionEngineException(errMsg);
@@ -457,17 +510,17 @@ namespace metadata
         return GetIl2CppTypeFromRawTypeDefIndex(rowIndex - 1);
     }
 
-    const Il2CppType* Image::ReadTypeFromTypeRef(uint32_t rowIndex)
+    const Il2CppType* Image::ReadTypeFromTypeRef(uint32_t rowIndex, bool raiseExceptionIfNotFound)
     {
         TbTypeRef r = _rawImage->ReadTypeRef(rowIndex);
-        return ReadTypeFromResolutionScope(r.resolutionScope, r.typeNamespace, r.typeName);
+        return ReadTypeFromResolutionScope(r.resolutionScope, r.typeNamespace, r.typeName, raiseExceptionIfNotFound);
     }
 
-    const Il2CppType* Image::ReadTypeFromTypeSpec(const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer, uint32_t rowIndex)
+    const Il2CppType* Image::ReadTypeFromTypeSpec(const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer, uint32_t rowIndex, bool raiseExceptionIfNotFound)
     {
         TbTypeSpec r = _rawImage->ReadTypeSpec(rowIndex);
         BlobReader reader = _rawImage->GetBlobReaderByRawIndex(r.signature);
-        return ReadType(reader, klassGenericContainer, methodGenericContainer);
+        return ReadType(reader, klassGenericContainer, methodGenericContainer, raiseExceptionIfNotFound);
     }
 
     const Il2CppType* Image::ReadTypeFromMemberRefParent(const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer, TableType tableType, uint32_t rowIndex)
@@ -478,7 +531,7 @@ namespace metadata
         return mrp.type;
     }
 
-    const Il2CppType* Image::ReadTypeFromToken(const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer, TableType tableType, uint32_t rowIndex)
+    const Il2CppType* Image::ReadTypeFromToken(const Il2CppGenericContainer* klassGenericContainer, const Il2CppGenericContainer* methodGenericContainer, TableType tableType, uint32_t rowIndex, bool raiseExceptionIfNotFound)
     {
         switch (tableType)
         {
@@ -488,11 +541,11 @@ namespace metadata
         }
         case TableType::TYPEREF:
         {
-            return ReadTypeFromTypeRef(rowIndex);
+            return ReadTypeFromTypeRef(rowIndex, raiseExceptionIfNotFound);
         }
         case TableType::TYPESPEC:
         {
-            return ReadTypeFromTypeSpec(klassGenericContainer, methodGenericContainer, rowIndex);
+            return ReadTypeFromTypeSpec(klassGenericContainer, methodGenericContainer, rowIndex, raiseExceptionIfNotFound);
         }
         default:
         {
@@ -760,6 +813,22 @@ namespace metadata
 
     void Image::ReadMethodBody(const Il2CppMethodDefinition& methodDef, const TbMethod& methodData, MethodBody& body)
     {
+        uint32_t localVarSigToken = ReadMethodBodyWithoutLocalVars(methodData, body);
+        if (localVarSigToken)
+        {
+            TbStandAloneSig sigData = _rawImage->ReadStandAloneSig(DecodeTokenRowIndex(localVarSigToken));
+
+            BlobReader reader = _rawImage->GetBlobReaderByRawIndex(sigData.signature);
+            ReadLocalVarSig(reader,
+                GetGenericContainerByTypeDefRawIndex(DecodeMetadataIndex(methodDef.declaringType)),
+                GetGenericContainerByRawIndex(DecodeMetadataIndex(methodDef.genericContainerIndex)),
+                body.localVars);
+        }
+    }
+
+    uint32_t Image::ReadMethodBodyWithoutLocalVars(const TbMethod& methodData, MethodBody& body) const
+    {
+        uint32_t localVarSigToken = 0;
         uint32_t bodyRVA = methodData.rva;
         if (bodyRVA > 0)
         {
@@ -786,17 +855,7 @@ namespace metadata
                 body.ilcodes = bodyStart + methodHeader->size * 4;
                 body.codeSize = methodHeader->codeSize;
                 body.maxStack = methodHeader->maxStack;
-
-                if (methodHeader->localVarSigToken)
-                {
-                    TbStandAloneSig sigData = _rawImage->ReadStandAloneSig(DecodeTokenRowIndex(methodHeader->localVarSigToken));
-
-                    BlobReader reader = _rawImage->GetBlobReaderByRawIndex(sigData.signature);
-                    ReadLocalVarSig(reader,
-                        GetGenericContainerByTypeDefRawIndex(DecodeMetadataIndex(methodDef.declaringType)),
-                        GetGenericContainerByRawIndex(DecodeMetadataIndex(methodDef.genericContainerIndex)),
-                        body.localVars);
-                }
+                localVarSigToken = methodHeader->localVarSigToken;
             }
             if (body.flags & (uint8_t)CorILMethodFormat::MoreSects)
             {
@@ -862,6 +921,7 @@ namespace metadata
             body.ilcodes = nullptr;
             body.codeSize = 0;
         }
+        return localVarSigToken;
     }
 
     const MethodInfo* Image::FindImplMethod(Il2CppClass* klass, const MethodInfo* method)
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <iostream>
 #include <algorithm>
+#include <thread>
 
 #include "il2cpp-class-internals.h"
 #include "vm/GlobalMetadata.h"
@@ -30,6 +31,9 @@
 #include "MetadataUtil.h"
 #include "ClassFieldLayoutCalculator.h"
 #include "MetadataPool.h"
+#include "ParallelTaskGraph.h"
+#include "../RuntimeConfig.h"
+#include "../MemoryStats.h"
 
 #include "../interpreter/Engine.h"
 #include "../interpreter/InterpreterModule.h"
@@ -39,7 +43,15 @@ namespace hybridclr
 namespace metadata
 {
 
+	// rows decoded at once by Read*Rows in init passes. keep it small enough to live on stack.
+	constexpr uint32_t kTableRowBatchSize = 256;
+
+	// rough estimate, not a measured constant: the parallel passes do little work per row, and below this many rows
+	// in their tables they finish in about the time it takes to start and attach a worker thread.
+	constexpr uint32_t kMinParallelInitRowCount = 8192;
+
 	static uint32_t s_nextImageIndexByKind[4] = { (1u << kMetadataImageIndexExtraShiftBitsA), 0, 0, 0};
+	static std::vector<uint32_t> s_freeImageIndexesByKind[4];
 
 	InterpreterImage* InterpreterImage::s_images[kMaxMetadataImageCount] = {};
 
@@ -70,6 +82,13 @@ namespace metadata
 		}
 		for (int32_t finalKind = kind; finalKind >= 0; finalKind--)
 		{
+			std::vector<uint32_t>& freeImageIndexes = s_freeImageIndexesByKind[finalKind];
+			if (!freeImageIndexes.empty())
+			{
+				uint32_t freeImageIndex = freeImageIndexes.back();
+				freeImageIndexes.pop_back();
+				return freeImageIndex;
+			}
 			uint32_t newImageIndex = s_nextImageIndexByKind[finalKind];
 			// 255 is preserved for invalid image index when kind is 3
 			if (newImageIndex >= kMaxMetadataImageIndexWithoutKind - (finalKind == 3))
@@ -82,6 +101,13 @@ namespace metadata
 		return kInvalidImageIndex;
 	}
 
+	void InterpreterImage::FreeImageIndex(uint32_t imageIndex)
+	{
+		IL2CPP_ASSERT(imageIndex != kInvalidImageIndex && s_images[imageIndex] == nullptr);
+		int32_t kind = (int32_t)(imageIndex >> (kMetadataImageIndexBits - kMetadataKindBits));
+		s_freeImageIndexesByKind[kind].push_back(imageIndex);
+	}
+
 	void InterpreterImage::RegisterImage(InterpreterImage* image)
 	{
 		il2cpp::os::Atomic::FullMemoryBarrier();
@@ -158,18 +184,24 @@ namespace metadata
 		InitParamDefs();
 		InitMethodDefs();
 		InitFieldDefs();
-		InitFieldLayouts();
-		InitFieldRVAs();
+
+		// these passes only read raw tables and write image-local data that no other pass in the group touches.
+		// passes which resolve types, use MetadataPool or may raise exceptions stay serialized.
+		ParallelTaskGraph graph;
+		graph.AddTask([this]() { InitFieldLayouts(); });
+		graph.AddTask([this]() { InitFieldRVAs(); });
+		graph.AddTask([this]() { InitMethodImpls0(); });
+		int32_t initProperties = graph.AddTask([this]() { InitProperties(); });
+		int32_t initEvents = graph.AddTask([this]() { InitEvents(); });
+		graph.AddTask([this]() { InitMethodSemantics(); }, { initProperties, initEvents });
+		int32_t initModuleRefs = graph.AddTask([this]() { InitModuleRefs(); });
+		graph.AddTask([this]() { InitImplMaps(); }, { initModuleRefs });
+		graph.AddTask([this]() { InitClassLayouts0(); });
+		graph.Run(ComputeInitWorkerCount());
+
 		InitBlittables();
-		InitMethodImpls0();
-		InitProperties();
-		InitEvents();
-		InitMethodSemantics();
 		InitConsts();
 		InitCustomAttributes();
-		InitModuleRefs();
-		InitImplMaps();
-		InitClassLayouts0();
 		InitHasFinalizers();
 		InitTypeDefs_2();
 		InitClassLayouts();
@@ -184,6 +216,31 @@ namespace metadata
 		_paramRawIndex2ActualParamIndex = nullptr;
 	}
 
+	uint32_t InterpreterImage::ComputeInitWorkerCount() const
+	{
+#if !IL2CPP_SUPPORT_THREADS
+		return 1;
+#else
+		int32_t maxWorkerCount = RuntimeConfig::GetMaxMetadataInitWorkerCount();
+		if (maxWorkerCount <= 1)
+		{
+			return 1;
+		}
+		// starting threads costs more than initializing small images.
+		uint32_t rowCount = 0;
+		for (TableType type : { TableType::FIELDLAYOUT, TableType::FIELDRVA, TableType::METHODIMPL, TableType::PROPERTY,
+			TableType::EVENT, TableType::METHODSEMANTICS, TableType::IMPLMAP, TableType::CLASSLAYOUT })
+		{
+			rowCount += _rawImage->GetTableRowNum(type);
+		}
+		if (rowCount < kMinParallelInitRowCount)
+		{
+			return 1;
+		}
+		return std::min((uint32_t)maxWorkerCount, std::max(std::thread::hardware_concurrency(), 1u));
+#endif
+	}
+
 	void InterpreterImage::InitTypeDefs_0()
 	{
 		const Table& typeDefTb = _rawImage->GetTable(TableType::TYPEDEF);
@@ -354,12 +411,11 @@ namespace metadata
 				cur.elementTypeIndex = _fieldDetails[DecodeMetadataIndex(cur.fieldStart)].fieldDef.typeIndex;
 			}
 
-			auto classLayoutRow = _classLayouts.find(typeIndex);
+			const TbClassLayout* classLayoutRow = _classLayouts.Find(typeIndex);
 			uint16_t packingSize = 0;
-			if (classLayoutRow != _classLayouts.end())
+			if (classLayoutRow)
 			{
-				auto& layoutData = classLayoutRow->second;
-				packingSize = layoutData.packingSize;
+				packingSize = classLayoutRow->packingSize;
 			}
 			else
 			{
@@ -414,6 +470,7 @@ namespace metadata
 			}
 		}
 
+		TbField rows[kTableRowBatchSize];
 		for (uint32_t i = 0, n = fieldTb.rowNum; i < n; i++)
 		{
 			FieldDetail& fd = _fieldDetails[i];
@@ -423,7 +480,12 @@ namespace metadata
 			fd.defaultValueIndex = kDefaultValueIndexNull;
 
 			uint32_t rowIndex = i + 1;
-			TbField data = _rawImage->ReadField(rowIndex);
+			uint32_t batchIndex = i % kTableRowBatchSize;
+			if (batchIndex == 0)
+			{
+				_rawImage->ReadFieldRows(rowIndex, std::min(kTableRowBatchSize, n - i), rows);
+			}
+			const TbField& data = rows[batchIndex];
 
 			BlobReader br = _rawImage->GetBlobReaderByRawIndex(data.signature);
 			FieldRefSig frs;
@@ -702,23 +764,26 @@ namespace metadata
 	void InterpreterImage::InitCustomAttributes()
 	{
 		const Table& tb = _rawImage->GetTable(TableType::CUSTOMATTRIBUTE);
-		_tokenCustomAttributes.reserve(tb.rowNum);
-
 
 		uint32_t threadStaticMethodToken = 0;
 		Il2CppCustomAttributeTypeRange* curTypeRange = nullptr;
+		TbCustomAttribute rows[kTableRowBatchSize];
 		for (uint32_t rowIndex = 1; rowIndex <= tb.rowNum; rowIndex++)
 		{
-			TbCustomAttribute data = _rawImage->ReadCustomAttribute(rowIndex);
+			uint32_t batchIndex = (rowIndex - 1) % kTableRowBatchSize;
+			if (batchIndex == 0)
+			{
+				_rawImage->ReadCustomAttributeRows(rowIndex, std::min(kTableRowBatchSize, tb.rowNum + 1 - rowIndex), rows);
+			}
+			const TbCustomAttribute& data = rows[batchIndex];
 			TableType parentType = DecodeHasCustomAttributeCodedIndexTableType(data.parent);
 			uint32_t parentRowIndex = DecodeHasCustomAttributeCodedIndexRowIndex(data.parent);
 			uint32_t token = EncodeToken(parentType, parentRowIndex);
 			if (curTypeRange == nullptr || curTypeRange->token != token)
 			{
-				IL2CPP_ASSERT(_tokenCustomAttributes.find(token) == _tokenCustomAttributes.end());
 				int32_t attributeStartIndex = EncodeWithIndex((int32_t)_customAttribues.size());
 				int32_t handleIndex = (int32_t)_customAttributeHandles.size();
-				_tokenCustomAttributes[token] = { (int32_t)EncodeWithIndex(handleIndex), false, nullptr, nullptr };
+				_tokenCustomAttributes.Add(token, { (int32_t)EncodeWithIndex(handleIndex), false, nullptr, nullptr });
 #ifdef HYBRIDCLR_UNITY_2021_OR_NEW
 				_customAttributeHandles.push_back({ token, (uint32_t)attributeStartIndex });
 #else
@@ -737,6 +802,20 @@ namespace metadata
 			//ReadMethodRefInfoFromToken(nullptr, nullptr, , ca.attrCtorMethod);
 			_customAttribues.push_back({ ctorMethodToken, data.value });
 
+			// the attribute type is taken from the ctor token alone, nothing gets resolved at load time
+			uint32_t attributeTypeToken = 0;
+			if (ctorMethodTableType == TableType::METHOD)
+			{
+				const Il2CppMethodDefinition& ctorDef = _methodDefines[ctorMethodRowIndex - 1];
+				attributeTypeToken = EncodeToken(TableType::TYPEDEF, DecodeMetadataIndex(ctorDef.declaringType) + 1);
+			}
+			else if (ctorMethodTableType == TableType::MEMBERREF)
+			{
+				TbMemberRef memberRef = _rawImage->ReadMemberRef(ctorMethodRowIndex);
+				attributeTypeToken = EncodeToken(DecodeMemberRefParentType(memberRef.classIdx), DecodeMemberRefParentRowIndex(memberRef.classIdx));
+			}
+			_customAttributeTypeIndex.push_back({ attributeTypeToken, token });
+
 			if (parentType == TableType::FIELD)
 			{
 				// try set thread static flags
@@ -755,41 +834,128 @@ namespace metadata
 			}
 
 		}
-		IL2CPP_ASSERT(_tokenCustomAttributes.size() == _customAttributeHandles.size());
+		_tokenCustomAttributes.Seal();
+		IL2CPP_ASSERT(_tokenCustomAttributes.Size() == _customAttributeHandles.size());
+		std::stable_sort(_customAttributeTypeIndex.begin(), _customAttributeTypeIndex.end(),
+			[](const CustomAttributeTypeIndexEntry& a, const CustomAttributeTypeIndexEntry& b) { return a.attributeTypeToken < b.attributeTypeToken; });
+		for (uint32_t i = 0, n = (uint32_t)_customAttributeTypeIndex.size(); i < n; i++)
+		{
+			uint32_t attributeTypeToken = _customAttributeTypeIndex[i].attributeTypeToken;
+			if (_customAttributeTypeGroups.empty() || _customAttributeTypeGroups.back().attributeTypeToken != attributeTypeToken)
+			{
+				_customAttributeTypeGroups.push_back({ attributeTypeToken, i, i, nullptr });
+			}
+			_customAttributeTypeGroups.back().entryEnd = i + 1;
+		}
 #ifdef HYBRIDCLR_UNITY_2021_OR_NEW
 		// add extra Il2CppCustomAttributeTypeRange for compute count
 		_customAttributeHandles.push_back({ 0, EncodeWithIndex((int32_t)_customAttribues.size()) });
 #endif
 #if !HYBRIDCLR_UNITY_2022_OR_NEW
-		_customAttribtesCaches.resize(_tokenCustomAttributes.size());
+		_customAttribtesCaches.resize(_tokenCustomAttributes.Size());
 #endif
 	}
 
+	// called with g_MetadataLock held. attribute types from assemblies that aren't loaded stay nullptr and are
+	// retried once another assembly is loaded, so one such attribute doesn't fail the whole query
+	void InterpreterImage::ResolveCustomAttributeClasses()
+	{
+		size_t assemblyCount = il2cpp::vm::Assembly::GetAllAssemblies()->size();
+		if (assemblyCount == _customAttributeResolveAssemblyCount)
+		{
+			return;
+		}
+		_customAttributeResolveAssemblyCount = assemblyCount;
+		bool allResolved = true;
+		for (CustomAttributeTypeGroup& group : _customAttributeTypeGroups)
+		{
+			if (group.klass || group.attributeTypeToken == 0)
+			{
+				continue;
+			}
+			const Il2CppType* type = ReadTypeFromToken(nullptr, nullptr, DecodeTokenTableType(group.attributeTypeToken), DecodeTokenRowIndex(group.attributeTypeToken), false);
+			group.klass = type ? il2cpp::vm::Class::FromIl2CppType(type, false) : nullptr;
+			allResolved = allResolved && group.klass;
+		}
+		if (allResolved)
+		{
+			_customAttributeClassesResolved.store(true, std::memory_order_release);
+		}
+	}
+
+	void InterpreterImage::CollectCustomAttributeParentTokens(Il2CppClass* attributeKlass, std::vector<uint32_t>& parentTokens) const
+	{
+		size_t firstTokenCount = parentTokens.size();
+		for (const CustomAttributeTypeGroup& group : _customAttributeTypeGroups)
+		{
+			if (group.klass && il2cpp::vm::Class::IsAssignableFrom(attributeKlass, group.klass))
+			{
+				for (uint32_t i = group.entryBegin; i < group.entryEnd; i++)
+				{
+					parentTokens.push_back(_customAttributeTypeIndex[i].parentToken);
+				}
+			}
+		}
+		// a member may carry several matching attributes
+		std::sort(parentTokens.begin() + firstTokenCount, parentTokens.end());
+		parentTokens.erase(std::unique(parentTokens.begin() + firstTokenCount, parentTokens.end()), parentTokens.end());
+	}
+
+	void InterpreterImage::GetCustomAttributeParentTokens(Il2CppClass* attributeKlass, std::vector<uint32_t>& parentTokens)
+	{
+		// once every attribute class is resolved the groups are immutable and queries don't take the lock
+		if (_customAttributeClassesResolved.load(std::memory_order_acquire))
+		{
+			CollectCustomAttributeParentTokens(attributeKlass, parentTokens);
+			return;
+		}
+		il2cpp::os::FastAutoLock metaLock(&il2cpp::vm::g_MetadataLock);
+		ResolveCustomAttributeClasses();
+		CollectCustomAttributeParentTokens(attributeKlass, parentTokens);
+	}
+
 #ifdef HYBRIDCLR_UNITY_2021_OR_NEW
 
 	void InterpreterImage::InitCustomAttributeData(CustomAttributesInfo& cai, const Il2CppCustomAttributeTypeRange& dataRange)
 	{
-		il2cpp::os::FastAutoLock metaLock(&il2cpp::vm::g_MetadataLock);
 		if (cai.inited)
 		{
 			return;
 		}
-		BuildCustomAttributesData(cai, dataRange);
+		// build without holding g_MetadataLock so threads materializing different attributes don't serialize.
+		// racing builders of the same entry produce identical data, the first publish wins and the others drop their copy.
+		CustomAttributeBlobWriters writers;
+		BuildCustomAttributesData(dataRange, writers);
+		uint32_t dataSize = writers.il2cppFormatData.Size();
+		void* resultData = HYBRIDCLR_MALLOC(dataSize);
+		std::memcpy(resultData, writers.il2cppFormatData.Data(), dataSize);
+		if (il2cpp::os::Atomic::CompareExchangePointer(&cai.dataStartPtr, resultData, (void*)nullptr) != nullptr)
+		{
+			HYBRIDCLR_FREE(resultData);
+			// the winner is only two stores away from setting inited
+			while (!*(volatile bool*)&cai.inited)
+			{
+				std::this_thread::yield();
+			}
+			return;
+		}
+		cai.dataEndPtr = (uint8_t*)resultData + dataSize;
+		MemoryStats::OnAllocate(MemoryCategory::CustomAttributeData, dataSize, _il2cppImage);
 		il2cpp::os::Atomic::FullMemoryBarrier();
 		cai.inited = true;
 	}
 
-	void InterpreterImage::BuildCustomAttributesData(CustomAttributesInfo& cai, const Il2CppCustomAttributeTypeRange& curTypeRange)
+	void InterpreterImage::BuildCustomAttributesData(const Il2CppCustomAttributeTypeRange& curTypeRange, CustomAttributeBlobWriters& writers)
 	{
 		hybridclr::interpreter::ExecutingInterpImageScope scope(hybridclr::interpreter::InterpreterModule::GetCurrentThreadMachineState(), this->_il2cppImage);
-		_il2cppFormatCustomDataBlob.Reset();
+		CustomAttributeDataWriter& dataBlob = writers.il2cppFormatData;
 		const Il2CppCustomAttributeDataRange& nextTypeRange = *(&curTypeRange + 1);
 		uint32_t attrCount = nextTypeRange.startOffset - curTypeRange.startOffset;
 		IL2CPP_ASSERT(attrCount > 0 && attrCount < 1024);
-		_il2cppFormatCustomDataBlob.WriteAttributeCount(attrCount);
+		dataBlob.WriteAttributeCount(attrCount);
 		int32_t attrStartOffset = DecodeMetadataIndex(curTypeRange.startOffset);
-		int32_t methodIndexDataOffset = _il2cppFormatCustomDataBlob.Size();
-		_il2cppFormatCustomDataBlob.Skip(attrCount * sizeof(int32_t));
+		int32_t methodIndexDataOffset = dataBlob.Size();
+		dataBlob.Skip(attrCount * sizeof(int32_t));
 		for (uint32_t i = 0; i < attrCount; i++)
 		{
 			const CustomAttribute& ca = _customAttribues[attrStartOffset + (int32_t)i];
@@ -797,25 +963,27 @@ namespace metadata
 			ReadMethodRefInfoFromToken(nullptr, nullptr, DecodeTokenTableType(ca.ctorMethodToken), DecodeTokenRowIndex(ca.ctorMethodToken), mri);
 			const MethodInfo* ctorMethod = GetMethodInfoFromMethodDef(mri.containerType, mri.methodDef);
 			MethodIndex ctorIndex = il2cpp::vm::GlobalMetadata::GetMethodIndexFromDefinition(mri.methodDef);
-			_il2cppFormatCustomDataBlob.WriteMethodIndex(methodIndexDataOffset, ctorIndex);
+			dataBlob.WriteMethodIndex(methodIndexDataOffset, ctorIndex);
 			methodIndexDataOffset += sizeof(int32_t);
 			if (ca.value != 0)
 			{
 				BlobReader reader = _rawImage->GetBlobReaderByRawIndex(ca.value);
-				ConvertILCustomAttributeData2Il2CppFormat(ctorMethod, reader);
+				ConvertILCustomAttributeData2Il2CppFormat(ctorMethod, reader, writers);
 			}
 			else
 			{
 				IL2CPP_ASSERT(mri.methodDef->parameterCount == 0);
-				_il2cppFormatCustomDataBlob.WriteCompressedUint32(0);
-				_il2cppFormatCustomDataBlob.WriteCompressedUint32(0);
-				_il2cppFormatCustomDataBlob.WriteCompressedUint32(0);
+				dataBlob.WriteCompressedUint32(0);
+				dataBlob.WriteCompressedUint32(0);
+				dataBlob.WriteCompressedUint32(0);
 			}
 		}
-		void* resultData = HYBRIDCLR_MALLOC(_il2cppFormatCustomDataBlob.Size());
-		std::memcpy(resultData, _il2cppFormatCustomDataBlob.Data(), _il2cppFormatCustomDataBlob.Size());
-		cai.dataStartPtr = resultData;
-		cai.dataEndPtr = (uint8_t*)resultData + _il2cppFormatCustomDataBlob.Size();
+	}
+
+	uint32_t InterpreterImage::AddIl2CppTypeCacheLocked(const Il2CppType* type)
+	{
+		il2cpp::os::FastAutoLock metaLock(&il2cpp::vm::g_MetadataLock);
+		return AddIl2CppTypeCache(type);
 	}
 
 	void InterpreterImage::WriteEncodeTypeEnum(CustomAttributeDataWriter& writer, const Il2CppType* type)
@@ -824,7 +992,7 @@ namespace metadata
 		if (type->type == IL2CPP_TYPE_ENUM || klass->enumtype)
 		{
 			writer.WriteByte((byte)IL2CPP_TYPE_ENUM);
-			int32_t typeIndex = type->type == IL2CPP_TYPE_CLASS || type->type == IL2CPP_TYPE_VALUETYPE ? ((Il2CppTypeDefinition*)type->data.typeHandle)->byvalTypeIndex : AddIl2CppTypeCache(type);
+			int32_t typeIndex = type->type == IL2CPP_TYPE_CLASS || type->type == IL2CPP_TYPE_VALUETYPE ? ((Il2CppTypeDefinition*)type->data.typeHandle)->byvalTypeIndex : AddIl2CppTypeCacheLocked(type);
 			writer.WriteCompressedInt32(typeIndex);
 		}
 		else if (klass == il2cpp_defaults.systemtype_class)
@@ -871,7 +1039,7 @@ namespace metadata
 		}
 		else
 		{
-			writer.WriteCompressedInt32(AddIl2CppTypeCache(type->type));
+			writer.WriteCompressedInt32(AddIl2CppTypeCacheLocked(type->type));
 		}
 	}
 
@@ -1036,7 +1204,7 @@ namespace metadata
 			{
 				writer.WriteByte((byte)IL2CPP_TYPE_ENUM);
 				IL2CPP_ASSERT(klass->enumtype);
-				int32_t typeIndex = klass->generic_class ? AddIl2CppTypeCache(type) : ((Il2CppTypeDefinition*)type->data.typeHandle)->byvalTypeIndex;
+				int32_t typeIndex = klass->generic_class ? AddIl2CppTypeCacheLocked(type) : ((Il2CppTypeDefinition*)type->data.typeHandle)->byvalTypeIndex;
 				writer.WriteCompressedInt32(typeIndex);
 			}
 			ConvertFixedArg(writer, reader, &klass->element_class->byval_arg, false);
@@ -1060,7 +1228,7 @@ namespace metadata
 			IL2CPP_ASSERT(klass->enumtype);
 			if (writeType)
 			{
-				int32_t typeIndex = klass->generic_class ? AddIl2CppTypeCache(type) : ((Il2CppTypeDefinition*)type->data.typeHandle)->byvalTypeIndex;
+				int32_t typeIndex = klass->generic_class ? AddIl2CppTypeCacheLocked(type) : ((Il2CppTypeDefinition*)type->data.typeHandle)->byvalTypeIndex;
 				writer.WriteCompressedInt32(typeIndex);
 			}
 			ConvertFixedArg(writer, reader, &klass->element_class->byval_arg, false);
@@ -1134,25 +1302,28 @@ namespace metadata
 #endif
 	}
 
-	void InterpreterImage::ConvertILCustomAttributeData2Il2CppFormat(const MethodInfo* ctorMethod, BlobReader& reader)
+	void InterpreterImage::ConvertILCustomAttributeData2Il2CppFormat(const MethodInfo* ctorMethod, BlobReader& reader, CustomAttributeBlobWriters& writers)
 	{
+		CustomAttributeDataWriter& ctorArgBlob = writers.ctorArgs;
+		CustomAttributeDataWriter& fieldBlob = writers.fields;
+		CustomAttributeDataWriter& propertyBlob = writers.properties;
 		uint16_t prolog = reader.Read16();
 		IL2CPP_ASSERT(prolog == 0x0001);
 		IL2CPP_ASSERT(!ctorMethod->is_generic);
 
-		_tempCtorArgBlob.Reset();
+		ctorArgBlob.Reset();
 		for (uint16_t i = 0; i < ctorMethod->parameters_count; i++)
 		{
 			const Il2CppType* paramType = GET_METHOD_PARAMETER_TYPE(ctorMethod->parameters[i]);
-			ConvertFixedArg(_tempCtorArgBlob, reader, paramType, true);
+			ConvertFixedArg(ctorArgBlob, reader, paramType, true);
 		}
 
 		uint16_t numNamed = reader.Read16();
 
 		uint32_t fieldCount = 0;
 		uint32_t propertyCount = 0;
-		_tempFieldBlob.Reset();
-		_tempPropertyBlob.Reset();
+		fieldBlob.Reset();
+		propertyBlob.Reset();
 		const Il2CppTypeDefinition* declaringType = GetUnderlyingTypeDefinition(&ctorMethod->klass->byval_arg);
 		for (uint16_t idx = 0; idx < numNamed; idx++)
 		{
@@ -1168,40 +1339,40 @@ namespace metadata
 			if (fieldOrPropTypeTag == 0x53)
 			{
 				++fieldCount;
-				ConvertFixedArg(_tempFieldBlob, reader, &fieldOrPropType, true);
+				ConvertFixedArg(fieldBlob, reader, &fieldOrPropType, true);
 				GetFieldDeclaringTypeIndexAndFieldIndexByName(declaringType, cstrName, fieldOrPropertyDeclaringTypeIndex, fieldOrPropertyIndex);
 				if (fieldOrPropertyDeclaringTypeIndex == kTypeDefinitionIndexInvalid)
 				{
-					_tempFieldBlob.WriteCompressedInt32(fieldOrPropertyIndex);
+					fieldBlob.WriteCompressedInt32(fieldOrPropertyIndex);
 				}
 				else
 				{
-					_tempFieldBlob.WriteCompressedInt32(-fieldOrPropertyIndex - 1);
-					_tempFieldBlob.WriteCompressedUint32(fieldOrPropertyDeclaringTypeIndex);
+					fieldBlob.WriteCompressedInt32(-fieldOrPropertyIndex - 1);
+					fieldBlob.WriteCompressedUint32(fieldOrPropertyDeclaringTypeIndex);
 				}
 			}
 			else
 			{
 				++propertyCount;
-				ConvertFixedArg(_tempPropertyBlob, reader, &fieldOrPropType, true);
+				ConvertFixedArg(propertyBlob, reader, &fieldOrPropType, true);
 				GetPropertyDeclaringTypeIndexAndPropertyIndexByName(declaringType, cstrName, fieldOrPropertyDeclaringTypeIndex, fieldOrPropertyIndex);
 				if (fieldOrPropertyDeclaringTypeIndex == kTypeDefinitionIndexInvalid)
 				{
-					_tempPropertyBlob.WriteCompressedInt32(fieldOrPropertyIndex);
+					propertyBlob.WriteCompressedInt32(fieldOrPropertyIndex);
 				}
 				else
 				{
-					_tempPropertyBlob.WriteCompressedInt32(-fieldOrPropertyIndex - 1);
-					_tempPropertyBlob.WriteCompressedUint32(fieldOrPropertyDeclaringTypeIndex);
+					propertyBlob.WriteCompressedInt32(-fieldOrPropertyIndex - 1);
+					propertyBlob.WriteCompressedUint32(fieldOrPropertyDeclaringTypeIndex);
 				}
 			}
 		}
-		_il2cppFormatCustomDataBlob.WriteCompressedUint32(ctorMethod->parameters_count);
-		_il2cppFormatCustomDataBlob.WriteCompressedUint32(fieldCount);
-		_il2cppFormatCustomDataBlob.WriteCompressedUint32(propertyCount);
-		_il2cppFormatCustomDataBlob.Write(_tempCtorArgBlob);
-		_il2cppFormatCustomDataBlob.Write(_tempFieldBlob);
-		_il2cppFormatCustomDataBlob.Write(_tempPropertyBlob);
+		writers.il2cppFormatData.WriteCompressedUint32(ctorMethod->parameters_count);
+		writers.il2cppFormatData.WriteCompressedUint32(fieldCount);
+		writers.il2cppFormatData.WriteCompressedUint32(propertyCount);
+		writers.il2cppFormatData.Write(ctorArgBlob);
+		writers.il2cppFormatData.Write(fieldBlob);
+		writers.il2cppFormatData.Write(propertyBlob);
 	}
 #endif
 
@@ -1419,7 +1590,6 @@ namespace metadata
 	void InterpreterImage::InitImplMaps()
 	{
 		const Table& implMapTb = _rawImage->GetTable(TableType::IMPLMAP);
-		_implMapInfos.reserve(implMapTb.rowNum);
 		for (uint32_t rid = 1; rid <= implMapTb.rowNum; rid++)
 		{
 			TbImplMap implMap = _rawImage->ReadImplMap(rid);
@@ -1428,8 +1598,9 @@ namespace metadata
 			info.importName = _rawImage->GetStringFromRawIndex(implMap.importName);
 			info.mappingFlags = implMap.mappingFlags;
 			uint32_t memberForwardedToken = hybridclr::metadata::ConvertMemberForwardedToken2Token(implMap.memberForwarded);
-			_implMapInfos.insert({ memberForwardedToken, info });
+			_implMapInfos.Add(memberForwardedToken, info);
 		}
+		_implMapInfos.Seal();
 	}
 
 	void InterpreterImage::InitMethodDefs0()
@@ -1462,11 +1633,17 @@ namespace metadata
 		}
 
 		int32_t paramTableRowNum = _rawImage->GetTable(TableType::PARAM).rowNum;
+		TbMethod rows[kTableRowBatchSize];
 		for (uint32_t index = 0; index < methodTb.rowNum; index++)
 		{
 			Il2CppMethodDefinition& md = _methodDefines[index];
 			uint32_t rowIndex = index + 1;
-			TbMethod methodData = _rawImage->ReadMethod(rowIndex);
+			uint32_t batchIndex = index % kTableRowBatchSize;
+			if (batchIndex == 0)
+			{
+				_rawImage->ReadMethodRows(rowIndex, std::min(kTableRowBatchSize, methodTb.rowNum - index), rows);
+			}
+			const TbMethod& methodData = rows[batchIndex];
 
 			md.nameIndex = EncodeWithIndex(methodData.name);
 			md.parameterStart = methodData.paramList - 1;
@@ -1475,6 +1652,8 @@ namespace metadata
 			md.flags = methodData.flags;
 			md.iflags = methodData.implFlags;
 			md.slot = kInvalidIl2CppMethodSlot;
+			// stash signature in returnType, which is filled by ReadMethodDefSig later.
+			md.returnType = (TypeIndex)methodData.signature;
 			if (index > 0)
 			{
 				auto& last = _methodDefines[index - 1];
@@ -1511,10 +1690,7 @@ namespace metadata
 				{
 					md.slot = slotIdx++;
 				}
-				// TODO 可以考虑优化一下,将 signature在前一步存到暂时不用的 returnType里
-				TbMethod methodData = _rawImage->ReadMethod(rawMethodStart + m + 1);
-
-				BlobReader methodSigReader = _rawImage->GetBlobReaderByRawIndex(methodData.signature);
+				BlobReader methodSigReader = _rawImage->GetBlobReaderByRawIndex((uint32_t)md.returnType);
 				uint32_t namedParamStart = md.parameterStart;
 				uint32_t namedParamCount = md.parameterCount;
 
@@ -1533,9 +1709,15 @@ namespace metadata
 					TEMP_FORMAT(errMsg, "method:%s.%s parameter count:%d is too large", _rawImage->GetStringFromRawIndex(DecodeMetadataIndex(typeDef.nameIndex)), methodName, md.parameterCount);
                     RaiseExecutionEngineException(errMsg);
 				}
+				TbParam paramRows[kTableRowBatchSize];
 				for (uint32_t paramRowIndex = namedParamStart + 1; paramRowIndex <= namedParamStart + namedParamCount; paramRowIndex++)
 				{
-					TbParam data = _rawImage->ReadParam(paramRowIndex);
+					uint32_t batchIndex = (paramRowIndex - namedParamStart - 1) % kTableRowBatchSize;
+					if (batchIndex == 0)
+					{
+						_rawImage->ReadParamRows(paramRowIndex, std::min(kTableRowBatchSize, namedParamStart + namedParamCount + 1 - paramRowIndex), paramRows);
+					}
+					const TbParam& data = paramRows[batchIndex];
 					if (data.sequence > 0)
 					{
 						int32_t actualParamIndex = actualParamStart + data.sequence - 1;
@@ -1810,13 +1992,14 @@ namespace metadata
 		for (uint32_t i = 0; i < classLayoutTb.rowNum; i++)
 		{
 			TbClassLayout data = _rawImage->ReadClassLayout(i + 1);
-			_classLayouts[data.parent - 1] = data;
+			_classLayouts.Add(data.parent - 1, data);
 			if (data.classSize > 0)
 			{
 				Il2CppTypeDefinitionSizes& typeSizes = _typeDetails[data.parent - 1].typeSizes;
 				typeSizes.instance_size = data.classSize + sizeof(Il2CppObject);
 			}
 		}
+		_classLayouts.Seal();
 	}
 
 	void InterpreterImage::InitClassLayouts()
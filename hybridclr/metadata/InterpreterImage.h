@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <unordered_map>
 
 #if HYBRIDCLR_UNITY_2021_OR_NEW
@@ -9,6 +10,7 @@
 
 #include "Image.h"
 #include "CustomAttributeDataWriter.h"
+#include "RowIndexedSparseArray.h"
 
 namespace hybridclr
 {
@@ -76,6 +78,22 @@ namespace metadata
 		uint32_t value;
 	};
 
+	// one entry per custom attribute row, sorted by attributeTypeToken
+	struct CustomAttributeTypeIndexEntry
+	{
+		uint32_t attributeTypeToken; // TypeDef, TypeRef or TypeSpec token of the attribute class
+		uint32_t parentToken;
+	};
+
+	// entries [entryBegin, entryEnd) of the sorted index share one attribute type
+	struct CustomAttributeTypeGroup
+	{
+		uint32_t attributeTypeToken;
+		uint32_t entryBegin;
+		uint32_t entryEnd;
+		Il2CppClass* klass; // resolved lazily, nullptr while its assembly isn't loaded
+	};
+
 	struct CustomAttributesInfo
 	{
 		int32_t typeRangeIndex;
@@ -108,6 +126,9 @@ namespace metadata
 
 		static uint32_t AllocImageIndex(uint32_t dllLength);
 
+		// return an index that was never published by RegisterImage, so a later load can reuse the slot
+		static void FreeImageIndex(uint32_t imageIndex);
+
 		static void RegisterImage(InterpreterImage* image);
 
 		static InterpreterImage* GetImage(uint32_t imageIndex)
@@ -125,8 +146,9 @@ namespace metadata
 
 		InterpreterImage(uint32_t imageIndex) : _index(imageIndex), _inited(false), _il2cppImage(nullptr)
 #if HYBRIDCLR_UNITY_2021_OR_NEW
-			, _constValues(1024), _il2cppFormatCustomDataBlob(256), _tempCtorArgBlob(256), _tempFieldBlob(256), _tempPropertyBlob(256)
+			, _constValues(1024)
 #endif
+			, _customAttributeClassesResolved(false), _customAttributeResolveAssemblyCount(0)
 		{
 
 		}
@@ -163,7 +185,7 @@ namespace metadata
 			return _index;
 		}
 
-		const Il2CppImage* GetIl2CppImage() const
+		const Il2CppImage* GetIl2CppImage() const override
 		{
 			return _il2cppImage;
 		}
@@ -178,6 +200,24 @@ namespace metadata
 			return rawIndex != 0 ? EncodeImageAndMetadataIndex(_index, rawIndex) : 0;
 		}
 
+		// the image method bodies are read from: the latest hot reloaded build, or this image
+		Image* GetMethodBodyImage()
+		{
+			return _hotReloadImages.empty() ? this : _hotReloadImages.back();
+		}
+
+		// patches are never freed, because frames still running older code and its cached strings reference them
+		void AddHotReloadImage(Image* image)
+		{
+			_hotReloadImages.push_back(image);
+		}
+
+		void RemoveLastHotReloadImage()
+		{
+			IL2CPP_ASSERT(!_hotReloadImages.empty());
+			_hotReloadImages.pop_back();
+		}
+
 		MethodBody* GetMethodBody(uint32_t token) override
 		{
 			IL2CPP_ASSERT(DecodeTokenTableType(token) == TableType::METHOD);
@@ -391,15 +431,15 @@ namespace metadata
 		int32_t GetPackingSize(const Il2CppTypeDefinition* typeDef) const
 		{
 			int32_t typeIndex = GetTypeRawIndex(typeDef);
-			auto it = _classLayouts.find(typeIndex);
-			return it != _classLayouts.end() ? it->second.packingSize : 0;
+			const TbClassLayout* layout = _classLayouts.Find(typeIndex);
+			return layout ? layout->packingSize : 0;
 		}
 
 		TbClassLayout GetClassLayout(const Il2CppTypeDefinition* typeDef) const
 		{
 			int32_t typeIndex = GetTypeRawIndex(typeDef);
-			auto it = _classLayouts.find(typeIndex);
-			return it != _classLayouts.end() ? it->second : TbClassLayout{};
+			const TbClassLayout* layout = _classLayouts.Find(typeIndex);
+			return layout ? *layout : TbClassLayout{};
 		}
 
 		const Il2CppFieldDefaultValue* GetFieldDefaultValueEntryByRawIndex(uint32_t index)
@@ -496,14 +536,17 @@ namespace metadata
 
 		Il2CppMetadataCustomAttributeHandle GetCustomAttributeTypeToken(uint32_t token)
 		{
-			auto it = _tokenCustomAttributes.find(token);
-			return it != _tokenCustomAttributes.end() ? (Il2CppMetadataCustomAttributeHandle)&_customAttributeHandles[DecodeMetadataIndex(it->second.typeRangeIndex)] : nullptr;
+			const CustomAttributesInfo* cai = _tokenCustomAttributes.Find(token);
+			return cai ? (Il2CppMetadataCustomAttributeHandle)&_customAttributeHandles[DecodeMetadataIndex(cai->typeRangeIndex)] : nullptr;
 		}
 
+		// tokens of all members carrying an attribute assignable to attributeKlass, without materializing any attribute.
+		void GetCustomAttributeParentTokens(Il2CppClass* attributeKlass, std::vector<uint32_t>& parentTokens);
+
 		CustomAttributeIndex GetCustomAttributeIndex(uint32_t token)
 		{
-			auto it = _tokenCustomAttributes.find(token);
-			return it != _tokenCustomAttributes.end() ? it->second.typeRangeIndex : kCustomAttributeIndexInvalid;
+			const CustomAttributesInfo* cai = _tokenCustomAttributes.Find(token);
+			return cai ? cai->typeRangeIndex : kCustomAttributeIndexInvalid;
 		}
 
 #if !HYBRIDCLR_UNITY_2021_OR_NEW
@@ -568,8 +611,7 @@ namespace metadata
 		il2cpp::metadata::CustomAttributeDataReader CreateCustomAttributeDataReader(Il2CppMetadataCustomAttributeHandle handle)
 		{
 			const Il2CppCustomAttributeTypeRange* dataRange = (const Il2CppCustomAttributeTypeRange*)handle;
-			IL2CPP_ASSERT(_tokenCustomAttributes.find(dataRange->token) != _tokenCustomAttributes.end());
-			CustomAttributesInfo& cai = _tokenCustomAttributes[dataRange->token];
+			CustomAttributesInfo& cai = *_tokenCustomAttributes.Find(dataRange->token);
 			if (!cai.inited)
 			{
 				InitCustomAttributeData(cai, *dataRange);
@@ -583,8 +625,7 @@ namespace metadata
 
 		std::tuple<void*, void*> CreateCustomAttributeDataTuple(const Il2CppCustomAttributeDataRange* dataRange)
 		{
-			IL2CPP_ASSERT(_tokenCustomAttributes.find(dataRange->token) != _tokenCustomAttributes.end());
-			CustomAttributesInfo& cai = _tokenCustomAttributes[dataRange->token];
+			CustomAttributesInfo& cai = *_tokenCustomAttributes.Find(dataRange->token);
 			if (!cai.inited)
 			{
 				InitCustomAttributeData(cai, *dataRange);
@@ -609,8 +650,20 @@ namespace metadata
 		CustomAttributesCache* GenerateCustomAttributesCacheInternal(CustomAttributeIndex index);
 #endif
 
-		void BuildCustomAttributesData(CustomAttributesInfo& cai, const Il2CppCustomAttributeTypeRange& typeRange);
-		void ConvertILCustomAttributeData2Il2CppFormat(const MethodInfo* ctorMethod, BlobReader& reader);
+		// scratch buffers of one materialization, kept per call so threads can convert attributes concurrently
+		struct CustomAttributeBlobWriters
+		{
+			CustomAttributeDataWriter il2cppFormatData;
+			CustomAttributeDataWriter ctorArgs;
+			CustomAttributeDataWriter fields;
+			CustomAttributeDataWriter properties;
+
+			CustomAttributeBlobWriters() : il2cppFormatData(256), ctorArgs(256), fields(256), properties(256) { }
+		};
+
+		void BuildCustomAttributesData(const Il2CppCustomAttributeTypeRange& typeRange, CustomAttributeBlobWriters& writers);
+		void ConvertILCustomAttributeData2Il2CppFormat(const MethodInfo* ctorMethod, BlobReader& reader, CustomAttributeBlobWriters& writers);
+		uint32_t AddIl2CppTypeCacheLocked(const Il2CppType* type);
 		void ConvertFixedArg(CustomAttributeDataWriter& writer, BlobReader& reader, const Il2CppType* type, bool writeType);
 		void ConvertBoxedValue(CustomAttributeDataWriter& writer, BlobReader& reader, bool writeType);
 		void ConvertSystemType(CustomAttributeDataWriter& writer, BlobReader& reader, bool writeType);
@@ -621,8 +674,7 @@ namespace metadata
 
 		ImplMapInfo* GetImplMapInfo(uint32_t token)
 		{
-			auto it = _implMapInfos.find(token);
-			return it != _implMapInfos.end() ? &it->second : nullptr;
+			return _implMapInfos.Find(token);
 		}
 
 		Il2CppClass* GetTypeInfoFromTypeDefinitionRawIndex(uint32_t index);
@@ -678,6 +730,9 @@ namespace metadata
 		void InitMethodSemantics();
 		void InitInterfaces();
 		void InitVTables();
+		uint32_t ComputeInitWorkerCount() const;
+		void ResolveCustomAttributeClasses();
+		void CollectCustomAttributeParentTokens(Il2CppClass* attributeKlass, std::vector<uint32_t>& parentTokens) const;
 
 		void ComputeBlittable(Il2CppTypeDefinition* def, std::vector<bool>& computFlags);
 		void ComputeHasFinalizer(Il2CppTypeDefinition *def, std::vector<bool> &computFlags);
@@ -705,6 +760,7 @@ namespace metadata
 		bool _inited;
 		Il2CppImage* _il2cppImage;
 		const uint32_t _index;
+		std::vector<Image*> _hotReloadImages;
 
 		std::vector<TypeDefinitionDetail> _typeDetails;
 		std::vector<Il2CppTypeDefinition> _typesDefines;
@@ -728,7 +784,7 @@ namespace metadata
 		std::vector<FieldDetail> _fieldDetails;
 		std::vector<Il2CppFieldDefaultValue> _fieldDefaultValues;
 
-		std::unordered_map<uint32_t, TbClassLayout> _classLayouts;
+		RowIndexedSparseArray<TbClassLayout> _classLayouts;
 		std::vector<uint32_t> _nestedTypeDefineIndexs;
 
 		// runtime data 
@@ -739,24 +795,22 @@ namespace metadata
 #endif
 
 
-		std::unordered_map<uint32_t, CustomAttributesInfo> _tokenCustomAttributes;
+		TokenIndexedSparseArray<CustomAttributesInfo> _tokenCustomAttributes;
 		std::vector<Il2CppCustomAttributeTypeRange> _customAttributeHandles;
 #if !HYBRIDCLR_UNITY_2022_OR_NEW
 		std::vector<CustomAttributesCache*> _customAttribtesCaches;
-#endif
-#if HYBRIDCLR_UNITY_2021_OR_NEW
-		CustomAttributeDataWriter _il2cppFormatCustomDataBlob;
-		CustomAttributeDataWriter _tempCtorArgBlob;
-		CustomAttributeDataWriter _tempFieldBlob;
-		CustomAttributeDataWriter _tempPropertyBlob;
 #endif
 		std::vector<CustomAttribute> _customAttribues;
+		std::vector<CustomAttributeTypeIndexEntry> _customAttributeTypeIndex;
+		std::vector<CustomAttributeTypeGroup> _customAttributeTypeGroups;
+		std::atomic<bool> _customAttributeClassesResolved;
+		size_t _customAttributeResolveAssemblyCount;
 
 		std::vector<PropertyDetail> _propeties;
 		std::vector<EventDetail> _events;
 
 		std::vector<const char*> _moduleRefs;
-		std::unordered_map<uint32_t, ImplMapInfo> _implMapInfos;
+		TokenIndexedSparseArray<ImplMapInfo> _implMapInfos;
 	};
 }
 }
\ No newline at end of file
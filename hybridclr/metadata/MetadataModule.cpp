@@ -41,7 +41,7 @@ namespace metadata
 
     Image* MetadataModule::GetUnderlyingInterpreterImage(const MethodInfo* methodInfo)
     {
-        return metadata::IsInterpreterMethod(methodInfo) ? hybridclr::metadata::MetadataModule::GetImage(methodInfo->klass)
+        return metadata::IsInterpreterMethod(methodInfo) ? hybridclr::metadata::MetadataModule::GetImage(methodInfo->klass)->GetMethodBodyImage()
             : (metadata::Image*)hybridclr::metadata::AOTHomologousImage::FindImageByAssembly(
                 methodInfo->klass->rank ? il2cpp_defaults.corlib->assembly : methodInfo->klass->image->assembly);
     }
@@ -1,5 +1,8 @@
 #include "MetadataPool.h"
 
+#include <atomic>
+
+#include "os/Mutex.h"
 #include "utils/MemoryPool.h"
 #include "vm/MetadataAlloc.h"
 #include "vm/MetadataLock.h"
@@ -47,7 +50,7 @@ namespace metadata
 			hash = HashUtils::Combine(hash, t1->byref);
 
 			hash = il2cpp::utils::HashUtils::Combine(hash, t1->attrs);
-			//hash = il2cpp::utils::HashUtils::Combine(hash, t1->num_mods);
+			hash = il2cpp::utils::HashUtils::Combine(hash, t1->num_mods);
 			hash = il2cpp::utils::HashUtils::Combine(hash, t1->pinned);
 			//hash = il2cpp::utils::HashUtils::Combine(hash, t1->valuetype);
 
@@ -123,6 +126,10 @@ namespace metadata
 
 		static bool AreEqual(const Il2CppType* t1, const Il2CppType* t2)
 		{
+			if (t1 == t2)
+			{
+				return true;
+			}
 			if (t1->type != t2->type)
 			{
 				return false;
@@ -130,6 +137,7 @@ namespace metadata
 
 			if (t1->byref != t2->byref
 				|| t1->attrs != t2->attrs
+				|| t1->num_mods != t2->num_mods
 				|| t1->pinned != t2->pinned)
 			{
 				return false;
@@ -220,10 +228,25 @@ namespace metadata
 
 
 	typedef Il2CppHashSet<const Il2CppType*, Il2CppTypeFullHash, Il2CppTypeFullEqualityComparer> Il2CppTypeHashSet;
-	static Il2CppTypeHashSet* s_Il2CppTypePool = nullptr;
+
+	// types are read from signatures on any thread, the pool is split by hash into shards with a lock each
+	// so concurrent readers rarely wait on each other.
+	constexpr size_t kTypePoolShardCount = 16;
+
+	struct Il2CppTypePoolShard
+	{
+		il2cpp::os::FastMutex lock;
+		Il2CppTypeHashSet types;
+	};
+
+	static Il2CppTypePoolShard* s_Il2CppTypePoolShards = nullptr;
 
 	typedef Il2CppHashSet<const Il2CppArrayType*, Il2CppArrayTypeHash2, Il2CppArrayTypeEqualityComparer2> Il2CppArrayTypeHashSet;
 	Il2CppArrayTypeHashSet* s_Il2CppArrayTypePool = nullptr;
+	static il2cpp::os::FastMutex s_Il2CppArrayTypePoolLock;
+
+	static std::atomic<uint64_t> s_pooledTypeCount(0);
+	static std::atomic<uint64_t> s_reusedTypeCount(0);
 
 
 	static void InitMetadataPool()
@@ -244,7 +267,7 @@ namespace metadata
 			byRefType.type = (Il2CppTypeEnum)i;
 			byRefType.byref = 1;
 		}
-		s_Il2CppTypePool = new Il2CppTypeHashSet();
+		s_Il2CppTypePoolShards = new Il2CppTypePoolShard[kTypePoolShardCount];
 		s_Il2CppArrayTypePool = new Il2CppArrayTypeHashSet();
 	}
 
@@ -305,15 +328,38 @@ namespace metadata
 
 	void MetadataPool::Initialize()
 	{
-		//InitMetadataPool();
-
+		if (!s_initializedMetadataPool)
+		{
+			InitMetadataPool();
+		}
 	}
 
+	// every component a type refers to is canonical: typedef handles and generic parameters are unique,
+	// generic classes are pooled by il2cpp, element types go through this pool. so types that are
+	// structurally equal can share one instance.
 	static bool NeedCache(const Il2CppType& originalType)
 	{
 		Il2CppTypeEnum type = originalType.type;
 		switch (type)
 		{
+		case IL2CPP_TYPE_PTR:
+		case IL2CPP_TYPE_SZARRAY:
+			return NeedCache(*originalType.data.type);
+		case IL2CPP_TYPE_ARRAY:
+			return NeedCache(*originalType.data.array->etype);
+		case IL2CPP_TYPE_GENERICINST:
+			return originalType.data.generic_class != nullptr;
+		default:
+			return true;
+		}
+	}
+
+	// kinds interned before every type was pooled: primitives, pointers and arrays of them, CLASS/VALUETYPE without typedef.
+	// reusing them saves nothing compared to that, so they are left out of the reuse count.
+	static bool IsBasicPooledType(const Il2CppType& originalType)
+	{
+		switch (originalType.type)
+		{
 		case IL2CPP_TYPE_VOID:
 		case IL2CPP_TYPE_BOOLEAN:
 		case IL2CPP_TYPE_CHAR:
@@ -334,12 +380,10 @@ namespace metadata
 			return true;
 		case IL2CPP_TYPE_PTR:
 		case IL2CPP_TYPE_SZARRAY:
-			return NeedCache(*originalType.data.type);
+			return IsBasicPooledType(*originalType.data.type);
 		case IL2CPP_TYPE_VALUETYPE:
 		case IL2CPP_TYPE_CLASS:
-		{
 			return originalType.data.typeHandle == nullptr;
-		}
 		default:
 			return false;
 		}
@@ -361,23 +405,35 @@ namespace metadata
 			return pooledType;
 		}
 
-		bool needCache = NeedCache(type);
-
-		if (needCache)
+		if (!NeedCache(type))
 		{
-			auto it = s_Il2CppTypePool->find(&type);
-			if (it != s_Il2CppTypePool->end())
-				return *it;
+			return DeepCloneIl2CppType(type);
 		}
-		Il2CppType* newType = DeepCloneIl2CppType(type);
-		if (needCache)
+
+		Il2CppTypePoolShard& shard = s_Il2CppTypePoolShards[Il2CppTypeFullHash::Hash(&type) % kTypePoolShardCount];
+		il2cpp::os::FastAutoLock lock(&shard.lock);
+		auto it = shard.types.find(&type);
+		if (it != shard.types.end())
 		{
-			auto ret = s_Il2CppTypePool->insert(newType);
-			IL2CPP_ASSERT(ret.second);
+			if (!IsBasicPooledType(type))
+			{
+				s_reusedTypeCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			return *it;
 		}
+		Il2CppType* newType = DeepCloneIl2CppType(type);
+		auto ret = shard.types.insert(newType);
+		IL2CPP_ASSERT(ret.second);
+		s_pooledTypeCount.fetch_add(1, std::memory_order_relaxed);
 		return newType;
 	}
 
+	void MetadataPool::GetPooledIl2CppTypeStats(uint64_t& pooledTypeCount, uint64_t& reusedTypeCount)
+	{
+		pooledTypeCount = s_pooledTypeCount.load(std::memory_order_relaxed);
+		reusedTypeCount = s_reusedTypeCount.load(std::memory_order_relaxed);
+	}
+
 	Il2CppType* MetadataPool::ShallowCloneIl2CppType(const Il2CppType* type)
 	{
 		Il2CppType* newType = MetadataMallocT<Il2CppType>();
@@ -394,6 +450,7 @@ namespace metadata
 
 		bool needCache = NeedCache(*elementType);
 
+		il2cpp::os::FastAutoLock lock(&s_Il2CppArrayTypePoolLock);
 		if (needCache)
 		{
 			auto it = s_Il2CppArrayTypePool->find(&type);
@@ -29,6 +29,12 @@ namespace metadata
 		static const Il2CppType* GetPooledIl2CppType(const Il2CppType& type);
 		static Il2CppType* ShallowCloneIl2CppType(const Il2CppType* type);
 		static const Il2CppArrayType* GetPooledIl2CppArrayType(const Il2CppType* elementType, uint32_t rank);
+
+		// reusedTypeCount only counts types that used to get a fresh copy per read (generic instances, generic params,
+		// byref or typedef class types, ...). each such reuse saves one sizeof(Il2CppType).
+		// the comparison speed-up of pooling (IsTypeEqual's pointer fast path) isn't counted: a shared counter on that
+		// path would cost about as much as the structural compare it skips. measure it with a native profiler instead.
+		static void GetPooledIl2CppTypeStats(uint64_t& pooledTypeCount, uint64_t& reusedTypeCount);
 	};
 }
 }
\ No newline at end of file
@@ -152,7 +152,8 @@ namespace metadata
 
 	bool IsTypeEqual(const Il2CppType* t1, const Il2CppType* t2)
 	{
-		return il2cpp::metadata::Il2CppTypeEqualityComparer::AreEqual(t1, t2);
+		// types read from metadata are pooled, equal ones usually are the same instance
+		return t1 == t2 || il2cpp::metadata::Il2CppTypeEqualityComparer::AreEqual(t1, t2);
 	}
 
 	bool IsTypeGenericCompatible(const Il2CppType* typeTo, const Il2CppType* typeFrom)
@@ -219,6 +220,10 @@ namespace metadata
 
 	bool IsSameOverrideType(const Il2CppType* t1, const Il2CppType* t2)
 	{
+		if (t1 == t2)
+		{
+			return true;
+		}
 		if (t1->type != t2->type)
 		{
 			return false;
@@ -9,6 +9,7 @@
 
 #include "utils/HashUtils.h"
 #include "../RuntimeConfig.h"
+#include "../MemoryStats.h"
 
 namespace hybridclr
 {
@@ -57,6 +58,12 @@ namespace metadata
 	static Il2CppHashMap<ImageTokenPair, MethodBodyCacheInfo*, ImageTokenPairHash, ImageTokenPairEqualTo> s_methodBodyCache;
 
 
+	static size_t GetMethodBodyMemorySize(const MethodBody* methodBody)
+	{
+		return sizeof(MethodBody) + methodBody->exceptionClauses.capacity() * sizeof(ExceptionClause)
+			+ methodBody->localVars.capacity() * sizeof(const Il2CppType*);
+	}
+
 	static MethodBodyCacheInfo* GetOrInitMethodBodyCache(hybridclr::metadata::Image* image, uint32_t token)
 	{
 		ImageTokenPair key = { image, token };
@@ -66,6 +73,10 @@ namespace metadata
 			return it->second;
 		}
 		MethodBody* methodBody = image->GetMethodBody(token);
+		if (methodBody)
+		{
+			MemoryStats::OnAllocate(MemoryCategory::MethodBody, GetMethodBodyMemorySize(methodBody), image->GetIl2CppImage());
+		}
 		MethodBodyCacheInfo* ci = (MethodBodyCacheInfo*)HYBRIDCLR_MALLOC_ZERO(sizeof(MethodBodyCacheInfo));
 		*ci = { methodBody, s_methodBodyCacheVersion, 0, InlineMode::None};
 		s_methodBodyCache[key] = ci;
@@ -80,6 +91,17 @@ namespace metadata
 		return ci->methodBody;
 	}
 
+	static void FreeMethodBodyCacheInfo(hybridclr::metadata::Image* image, MethodBodyCacheInfo* ci)
+	{
+		if (ci->methodBody)
+		{
+			MemoryStats::OnFree(MemoryCategory::MethodBody, GetMethodBodyMemorySize(ci->methodBody), image->GetIl2CppImage());
+			ci->methodBody->~MethodBody();
+			HYBRIDCLR_FREE(ci->methodBody);
+		}
+		HYBRIDCLR_FREE(ci);
+	}
+
 	static void ShrinkMethodBodyCache(int32_t shrinkMethodBodyCacheInterval)
 	{
 		if (s_methodBodyCache.size() <= RuntimeConfig::GetMaxMethodBodyCacheSize())
@@ -95,12 +117,7 @@ namespace metadata
 			int32_t accessVersion = ci->accessVersion + (ci->accessCount - 1) * shrinkMethodBodyCacheInterval;
 			if (accessVersion < expiredVersion)
 			{
-				if (ci->methodBody)
-				{
-					ci->methodBody->~MethodBody();
-					HYBRIDCLR_FREE(ci->methodBody);
-				}
-				HYBRIDCLR_FREE(ci);
+				FreeMethodBodyCacheInfo(it->first.image, ci);
 				s_methodBodyCache.erase(it++);
 			}
 			else
@@ -125,6 +142,22 @@ namespace metadata
 		}
 	}
 
+	void MethodBodyCache::RemoveImage(hybridclr::metadata::Image* image)
+	{
+		for (auto it = s_methodBodyCache.begin(); it != s_methodBodyCache.end(); )
+		{
+			if (it->first.image == image)
+			{
+				FreeMethodBodyCacheInfo(image, it->second);
+				s_methodBodyCache.erase(it++);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
 	static bool IsILCodeInlineable(const byte* ilcodeStart, uint32_t codeSize)
 	{
 		const byte* codeEnd = ilcodeStart + codeSize;
@@ -11,6 +11,8 @@ namespace metadata
 	public:
 		static MethodBody* GetMethodBody(hybridclr::metadata::Image* image, uint32_t token);
 		static void EnableShrinkMethodBodyCache(bool shrink);
+		// free the cached bodies of an image that no longer supplies method bodies
+		static void RemoveImage(hybridclr::metadata::Image* image);
 
 		static bool IsInlineable(const MethodInfo* method);
 		static void DisableInline(const MethodInfo* method);
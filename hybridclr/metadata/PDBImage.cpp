@@ -2,9 +2,8 @@
 
 #include <algorithm>
 
-#include "vm/MetadataLock.h"
-
 #include "../interpreter/InterpreterDefs.h"
+#include "../MemoryStats.h"
 
 #include "BlobReader.h"
 
@@ -24,21 +23,15 @@ namespace metadata
 		return LoadImageErrorCode::OK;
 	}
 
-	uint32_t PDBImage::FindILOffsetByIROffset(const il2cpp::utils::dynamic_array<ILMapper>& ilMapper, uint32_t irOffset)
+	const MethodDebugInfoEntry* PDBImage::FindMethodDebugInfoEntry(const MethodDebugInfo* debugInfo, uint32_t irOffset)
 	{
-		auto it = std::upper_bound(ilMapper.begin(), ilMapper.end(), irOffset, [](uint32_t irOffset, const ILMapper& mapper) { return irOffset < mapper.irOffset; });
-		if (it != ilMapper.begin())
-		{
-			auto next = it;
-			if (next != ilMapper.end())
-			{
-				IL2CPP_ASSERT(next->irOffset > irOffset);
-			}
-			--it;
-			IL2CPP_ASSERT(it->irOffset <= irOffset);
-			return it->ilOffset;
-		}
-		return 0;
+		const MethodDebugInfoEntry* begin = debugInfo->entries;
+		const MethodDebugInfoEntry* end = begin + debugInfo->entryCount;
+		auto it = std::upper_bound(begin, end, irOffset, [](uint32_t irOffset, const MethodDebugInfoEntry& entry) { return irOffset < entry.irOffset; });
+		IL2CPP_ASSERT(it != begin);
+		--it;
+		IL2CPP_ASSERT(it->irOffset <= irOffset);
+		return it;
 	}
 
 	const PDBImage::SymbolSequencePoint* PDBImage::FindSequencePoint(const il2cpp::utils::dynamic_array<SymbolSequencePoint>& sequencePoints, uint32_t ilOffset)
@@ -58,7 +51,7 @@ namespace metadata
 		return nullptr;
 	}
 
-	const PDBImage::SymbolDocumentData* PDBImage::GetDocument(uint32_t documentToken)
+	const PDBImage::SymbolDocumentData* PDBImage::GetDocument(uint32_t documentToken, const Il2CppImage* ownerImage)
 	{
 		const Table& tableMeta = GetTable(TableType::DOCUMENT);
 		uint32_t rowIndex = DecodeTokenRowIndex(documentToken);
@@ -96,63 +89,82 @@ namespace metadata
 			first = false;
 		}
 		documentData->sourceFiles = CopyString(sourceFileNames.c_str());
+		MemoryStats::OnAllocate(MemoryCategory::DebugInfo, sizeof(SymbolDocumentData) + sourceFileNames.length() + 1, ownerImage);
 
 		_documents.add(documentToken, documentData);
 		return documentData;
 	}
 
-	void PDBImage::SetupStackFrameInfo(const MethodInfo* method, const void* ip, Il2CppStackFrameInfo& stackFrame)
+	void PDBImage::SetupStackFrameInfo(const interpreter::InterpMethodInfo* imi, const void* ip, Il2CppStackFrameInfo& stackFrame)
 	{
-		il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
-		auto it = _methodInfos.find(method);
-		if (it == _methodInfos.end())
+		if (!imi || !imi->debugInfo)
 		{
 			return;
 		}
-		const SymbolMethodInfoData* methodInfoData = it->second;
-		const SymbolMethodDefData* methodData = methodInfoData->methodData;
-		const hybridclr::interpreter::InterpMethodInfo* imi = (const hybridclr::interpreter::InterpMethodInfo*)method->interpData;
 		IL2CPP_ASSERT(ip >= imi->codes && ip < imi->codes + imi->codeLength);
 		const byte* actualIp = (const byte*)ip;
 
 		uint32_t irOffset = (uint32_t)((uintptr_t)actualIp - (uintptr_t)imi->codes);
-		uint32_t ilOffset = FindILOffsetByIROffset(methodInfoData->ilMapper, irOffset);
+		const MethodDebugInfoEntry* entry = FindMethodDebugInfoEntry(imi->debugInfo, irOffset);
+		stackFrame.ilOffset = entry->ilOffset;
+		stackFrame.sourceCodeLineNumber = entry->line;
+		if (entry->filePath)
+		{
+			stackFrame.filePath = entry->filePath;
+		}
+	}
+
+	void PDBImage::SetupMethodDebugInfoEntry(const SymbolMethodDefData* methodData, uint32_t irOffset, uint32_t ilOffset, const Il2CppImage* ownerImage, MethodDebugInfoEntry& entry)
+	{
 		// when call sub interpreter method, ip point to next instruction, so we need to adjust ilOffset.
 		if (ilOffset > 0)
 		{
 			--ilOffset;
 		}
-		stackFrame.ilOffset = ilOffset;
+		entry.irOffset = irOffset;
+		entry.ilOffset = ilOffset;
 
 		const SymbolSequencePoint* ssp = FindSequencePoint(methodData->sequencePoints, ilOffset);
-		if (!ssp)
+		if (ssp)
 		{
-			stackFrame.sourceCodeLineNumber = 0;
-			return;
+			entry.line = ssp->line;
+			entry.filePath = GetDocumentName(ssp->document, ownerImage);
+		}
+		else
+		{
+			entry.line = 0;
+			entry.filePath = nullptr;
 		}
-
-		stackFrame.sourceCodeLineNumber = ssp->line;
-
-		stackFrame.filePath = GetDocumentName(ssp->document);
 	}
 
-	void PDBImage::SetMethodDebugInfo(const MethodInfo* method, const il2cpp::utils::dynamic_array<ILMapper>& ilMapper)
+	const MethodDebugInfo* PDBImage::CreateMethodDebugInfo(const MethodInfo* method, const il2cpp::utils::dynamic_array<ILMapper>& ilMapper)
 	{
-		IL2CPP_ASSERT(_methodInfos.find(method) == _methodInfos.end());
-		SymbolMethodDefData* methodData = GetMethodDataFromCache(method->token);
+		const Il2CppImage* ownerImage = method->klass->image;
+		SymbolMethodDefData* methodData = GetMethodDataFromCache(method->token, ownerImage);
 		if (!methodData)
 		{
-			return;
+			return nullptr;
 		}
 
-		SymbolMethodInfoData* methodInfoData = new (HYBRIDCLR_MALLOC_ZERO(sizeof(SymbolMethodInfoData))) SymbolMethodInfoData();
-		methodInfoData->methodData = methodData;
-		methodInfoData->ilMapper = ilMapper;
-		_methodInfos.add(method, methodInfoData);
-	}
+		// entries[0] covers the instructions before the first mapped one.
+		uint32_t entryCount = (uint32_t)ilMapper.size() + 1;
+		MethodDebugInfoEntry* entries = (MethodDebugInfoEntry*)HYBRIDCLR_MALLOC_ZERO(entryCount * sizeof(MethodDebugInfoEntry));
+		SetupMethodDebugInfoEntry(methodData, 0, 0, ownerImage, entries[0]);
+		for (uint32_t i = 1; i < entryCount; i++)
+		{
+			const ILMapper& mapper = ilMapper[i - 1];
+			IL2CPP_ASSERT(mapper.irOffset >= entries[i - 1].irOffset);
+			SetupMethodDebugInfoEntry(methodData, mapper.irOffset, mapper.ilOffset, ownerImage, entries[i]);
+		}
 
+		MethodDebugInfo* debugInfo = (MethodDebugInfo*)HYBRIDCLR_MALLOC_ZERO(sizeof(MethodDebugInfo));
+		debugInfo->entries = entries;
+		debugInfo->entryCount = entryCount;
+		MemoryStats::OnAllocate(MemoryCategory::DebugInfo, sizeof(MethodDebugInfo) + entryCount * sizeof(MethodDebugInfoEntry), ownerImage);
+		return debugInfo;
+	}
 
-	PDBImage::SymbolMethodDefData* PDBImage::GetMethodDataFromCache(uint32_t methodToken)
+	PDBImage::SymbolMethodDefData* PDBImage::GetMethodDataFromCache(uint32_t methodToken, const Il2CppImage* ownerImage)
 	{
 		const Table& tableMeta = GetTable(TableType::METHODDEBUGINFORMATION);
 		uint32_t rowIndex = hybridclr::metadata::DecodeTokenRowIndex(methodToken);
@@ -225,6 +237,7 @@ namespace metadata
 			}
 		}
 
+		MemoryStats::OnAllocate(MemoryCategory::DebugInfo, sizeof(SymbolMethodDefData) + methodData->sequencePoints.capacity() * sizeof(SymbolSequencePoint), ownerImage);
 		_methods.add(methodToken, methodData);
 		return methodData;
 	}
@@ -4,6 +4,11 @@
 
 namespace hybridclr
 {
+namespace interpreter
+{
+	struct InterpMethodInfo;
+}
+
 namespace metadata
 {
 	struct ILMapper
@@ -12,6 +17,22 @@ namespace metadata
 		uint32_t ilOffset;
 	};
 
+	struct MethodDebugInfoEntry
+	{
+		uint32_t irOffset;
+		uint32_t ilOffset;
+		uint32_t line;
+		const char* filePath;
+	};
+
+	// resolved at transform time and attached to InterpMethodInfo, so stack frames can be symbolized without lock.
+	struct MethodDebugInfo
+	{
+		// sorted by irOffset. entries[0].irOffset is always 0.
+		const MethodDebugInfoEntry* entries;
+		uint32_t entryCount;
+	};
+
 	class PDBImage : public RawImageBase
 	{
 	public:
@@ -27,8 +48,9 @@ namespace metadata
 			return nullptr;
 		}
 
-		void SetupStackFrameInfo(const MethodInfo* method, const void* ip, Il2CppStackFrameInfo& stackFrame);
-		void SetMethodDebugInfo(const MethodInfo* method, const il2cpp::utils::dynamic_array<ILMapper>& ilMapper);
+		// imi is the code the frame runs, which is not always the current interpData of its method after a hot reload.
+		static void SetupStackFrameInfo(const interpreter::InterpMethodInfo* imi, const void* ip, Il2CppStackFrameInfo& stackFrame);
+		const MethodDebugInfo* CreateMethodDebugInfo(const MethodInfo* method, const il2cpp::utils::dynamic_array<ILMapper>& ilMapper);
 	private:
 
 		struct SymbolDocumentData
@@ -52,19 +74,15 @@ namespace metadata
 			il2cpp::utils::dynamic_array<SymbolSequencePoint> sequencePoints;
 		};
 
-		struct SymbolMethodInfoData
-		{
-			SymbolMethodDefData* methodData;
-			il2cpp::utils::dynamic_array<ILMapper> ilMapper;
-		};
-
-		SymbolMethodDefData* GetMethodDataFromCache(uint32_t methodToken);
-		static uint32_t FindILOffsetByIROffset(const il2cpp::utils::dynamic_array<ILMapper>& ilMapper, uint32_t irOffset);
+		// ownerImage is the image the cached data is accounted to in MemoryStats
+		SymbolMethodDefData* GetMethodDataFromCache(uint32_t methodToken, const Il2CppImage* ownerImage);
+		void SetupMethodDebugInfoEntry(const SymbolMethodDefData* methodData, uint32_t irOffset, uint32_t ilOffset, const Il2CppImage* ownerImage, MethodDebugInfoEntry& entry);
+		static const MethodDebugInfoEntry* FindMethodDebugInfoEntry(const MethodDebugInfo* debugInfo, uint32_t irOffset);
 		static const SymbolSequencePoint* FindSequencePoint(const il2cpp::utils::dynamic_array<SymbolSequencePoint>& sequencePoints, uint32_t ilOffset);
-		const SymbolDocumentData* GetDocument(uint32_t documentToken);
-		const char* GetDocumentName(uint32_t documentToken)
+		const SymbolDocumentData* GetDocument(uint32_t documentToken, const Il2CppImage* ownerImage);
+		const char* GetDocumentName(uint32_t documentToken, const Il2CppImage* ownerImage)
 		{
-			const SymbolDocumentData* document = GetDocument(documentToken);
+			const SymbolDocumentData* document = GetDocument(documentToken, ownerImage);
 			return document ? document->sourceFiles : nullptr;
 		}
 
@@ -73,9 +91,6 @@ namespace metadata
 
 		typedef Il2CppHashMap<uint32_t, SymbolDocumentData*, il2cpp::utils::PassThroughHash<uint32_t>> SymbolDocumentDataMap;
 		SymbolDocumentDataMap _documents;
-
-		typedef Il2CppHashMap<const MethodInfo*, SymbolMethodInfoData*, il2cpp::utils::PassThroughHash<const MethodInfo*>> SymbolMethodInfoDataMap;
-		SymbolMethodInfoDataMap _methodInfos;
 	};
 }
 }
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "ParallelTaskGraph.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "vm/Domain.h"
+#include "vm/Thread.h"
+
+namespace hybridclr
+{
+namespace metadata
+{
+	int32_t ParallelTaskGraph::AddTask(Task task, std::initializer_list<int32_t> dependencies)
+	{
+		int32_t taskIndex = (int32_t)_tasks.size();
+		for (int32_t dep : dependencies)
+		{
+			IL2CPP_ASSERT(dep >= 0 && dep < taskIndex);
+			_tasks[dep].successors.push_back(taskIndex);
+		}
+		_tasks.push_back({ task, {}, (int32_t)dependencies.size() });
+		return taskIndex;
+	}
+
+	void ParallelTaskGraph::Run(uint32_t workerCount)
+	{
+#if IL2CPP_SUPPORT_THREADS
+		if (workerCount <= 1 || _tasks.size() <= 1)
+#endif
+		{
+			for (TaskNode& node : _tasks)
+			{
+				node.task();
+			}
+			return;
+		}
+#if IL2CPP_SUPPORT_THREADS
+
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::vector<int32_t> readyTasks;
+		std::vector<int32_t> pendingDependencyCounts(_tasks.size());
+		size_t finishedTaskCount = 0;
+		std::exception_ptr firstError;
+
+		for (size_t i = 0; i < _tasks.size(); i++)
+		{
+			pendingDependencyCounts[i] = _tasks[i].dependencyCount;
+			if (_tasks[i].dependencyCount == 0)
+			{
+				readyTasks.push_back((int32_t)i);
+			}
+		}
+
+		auto workerMain = [&]()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			for (;;)
+			{
+				cv.wait(lock, [&]() { return !readyTasks.empty() || finishedTaskCount == _tasks.size() || firstError; });
+				if (readyTasks.empty() || firstError)
+				{
+					return;
+				}
+				int32_t taskIndex = readyTasks.back();
+				readyTasks.pop_back();
+				lock.unlock();
+				std::exception_ptr error;
+				try
+				{
+					_tasks[taskIndex].task();
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+				lock.lock();
+				++finishedTaskCount;
+				if (error && !firstError)
+				{
+					firstError = error;
+				}
+				for (int32_t succ : _tasks[taskIndex].successors)
+				{
+					if (--pendingDependencyCounts[succ] == 0)
+					{
+						readyTasks.push_back(succ);
+					}
+				}
+				cv.notify_all();
+			}
+		};
+
+		uint32_t threadCount = std::min(workerCount, (uint32_t)_tasks.size()) - 1;
+		std::vector<std::thread> workers;
+		workers.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; i++)
+		{
+			// tasks may raise il2cpp exceptions, which allocate managed objects, so workers are attached threads.
+			workers.emplace_back([&workerMain]()
+			{
+				Il2CppThread* thread = il2cpp::vm::Thread::Attach(il2cpp::vm::Domain::GetCurrent());
+				workerMain();
+				il2cpp::vm::Thread::Detach(thread);
+			});
+		}
+		workerMain();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		if (firstError)
+		{
+			std::rethrow_exception(firstError);
+		}
+#endif
+	}
+}
+}
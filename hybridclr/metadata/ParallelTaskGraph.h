@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <initializer_list>
+
+#include "../CommonDef.h"
+
+namespace hybridclr
+{
+namespace metadata
+{
+	// a small dependency graph of coarse tasks, executed on a few short-lived worker threads.
+	// tasks must be added after their dependencies, so insertion order is a valid sequential order.
+	class ParallelTaskGraph
+	{
+	public:
+		typedef std::function<void()> Task;
+
+		int32_t AddTask(Task task, std::initializer_list<int32_t> dependencies = {});
+
+		// run with at most workerCount threads, including the calling thread. sequential without IL2CPP_SUPPORT_THREADS.
+		// the first exception thrown by a task is rethrown on the calling thread after all workers stop.
+		void Run(uint32_t workerCount);
+
+	private:
+		struct TaskNode
+		{
+			Task task;
+			std::vector<int32_t> successors;
+			int32_t dependencyCount;
+		};
+
+		std::vector<TaskNode> _tasks;
+	};
+}
+}
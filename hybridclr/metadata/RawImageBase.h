@@ -25,6 +25,8 @@ namespace metadata
 		UNKNOWN_IMAGE_FORMAT,
 		UNSUPPORT_FORMAT_VERSION,
 		UNMATCH_FORMAT_VARIANT,
+		HOT_RELOAD_ONLY_SUPPORT_INTERPRETER_ASSEMBLY,
+		HOT_RELOAD_INCOMPATIBLE_METADATA,
 	};
 
 	class RawImageBase
@@ -58,6 +60,12 @@ namespace metadata
 			return CreateUserString((const char*)(str + lengthSize), stringLength);
 		}
 
+		BlobReader GetUserStringBlobByRawIndex(uint32_t index) const
+		{
+			IL2CPP_ASSERT(index < _streamUS.size);
+			return DecodeBlob(_streamUS.data + index);
+		}
+
 		const char* GetStringFromRawIndex(StringIndex index) const
 		{
 			IL2CPP_ASSERT(DecodeImageIndex(index) == 0);
@@ -262,6 +270,42 @@ namespace metadata
 			value = columnMt.size == 2 ? GetU2LittleEndian(dataPtr) : GetU4LittleEndian(dataPtr);
 		}
 
+		// decode one column of rows [rawIndexBegin, rawIndexBegin + count) into field of rows.
+		// column width is dispatched once for the whole column instead of once per row.
+		template<typename Row, typename Field>
+		static void DecodeColumn(const byte* firstRowPtr, uint32_t rowSize, const ColumnOffsetSize& columnMt, uint32_t count, Row* rows, Field Row::* field)
+		{
+			const byte* dataPtr = firstRowPtr + columnMt.offset;
+			switch (columnMt.size)
+			{
+			case 1:
+			{
+				for (uint32_t i = 0; i < count; i++, dataPtr += rowSize)
+				{
+					rows[i].*field = (Field)*dataPtr;
+				}
+				break;
+			}
+			case 2:
+			{
+				for (uint32_t i = 0; i < count; i++, dataPtr += rowSize)
+				{
+					rows[i].*field = (Field)GetU2LittleEndian(dataPtr);
+				}
+				break;
+			}
+			case 4:
+			{
+				for (uint32_t i = 0; i < count; i++, dataPtr += rowSize)
+				{
+					rows[i].*field = (Field)GetU4LittleEndian(dataPtr);
+				}
+				break;
+			}
+			default: IL2CPP_ASSERT(false); break;
+			}
+		}
+
 		static Il2CppString* CreateUserString(const char* str, uint32_t length)
 		{
 			if (length == 0)
@@ -292,27 +336,62 @@ namespace metadata
 #define TABLE_END return __r; \
         }
 
+#define TABLE_ROWS_BEGIN(name, tableType) void Read##name##Rows(uint32_t rawIndexBegin, uint32_t count, Tb##name* rows) const \
+        { \
+        if (count == 0) \
+        { \
+            return; \
+        } \
+        IL2CPP_ASSERT(rawIndexBegin + count - 1 <= GetTable(tableType).rowNum); \
+        typedef Tb##name __RowType; \
+        const byte* rowPtr = GetTableRowPtr(tableType, rawIndexBegin); \
+        uint32_t rowSize = GetTable(tableType).rowMetaDataSize; \
+        auto& rowSchema = GetRowSchema(tableType); \
+        uint32_t __fieldIndex = 0;
+
+#define __RF(fieldName) DecodeColumn(rowPtr, rowSize, rowSchema[__fieldIndex++], count, rows, &__RowType::fieldName);
+
+#define TABLE_ROWS_END }
+
 #define TABLE1(name, tableType, f1) TABLE_BEGIN(name, tableType) \
 __F(f1) \
-TABLE_END
+TABLE_END \
+TABLE_ROWS_BEGIN(name, tableType) \
+__RF(f1) \
+TABLE_ROWS_END
 
 #define TABLE2(name, tableType, f1, f2) TABLE_BEGIN(name, tableType) \
 __F(f1) \
 __F(f2) \
-TABLE_END
+TABLE_END \
+TABLE_ROWS_BEGIN(name, tableType) \
+__RF(f1) \
+__RF(f2) \
+TABLE_ROWS_END
 
 #define TABLE3(name, tableType, f1, f2, f3) TABLE_BEGIN(name, tableType) \
 __F(f1) \
 __F(f2) \
 __F(f3) \
-TABLE_END
+TABLE_END \
+TABLE_ROWS_BEGIN(name, tableType) \
+__RF(f1) \
+__RF(f2) \
+__RF(f3) \
+TABLE_ROWS_END
 
 #define TABLE4(name, tableType, f1, f2, f3, f4) TABLE_BEGIN(name, tableType) \
 __F(f1) \
 __F(f2) \
 __F(f3) \
 __F(f4) \
-TABLE_END
+TABLE_END \
+TABLE_ROWS_BEGIN(name, tableType) \
+__RF(f1) \
+__RF(f2) \
+__RF(f3) \
+__RF(f4) \
+TABLE_ROWS_END
 
 #define TABLE5(name, tableType, f1, f2, f3, f4, f5) TABLE_BEGIN(name, tableType) \
 __F(f1) \
@@ -320,7 +399,14 @@ __F(f2) \
 __F(f3) \
 __F(f4) \
 __F(f5) \
-TABLE_END
+TABLE_END \
+TABLE_ROWS_BEGIN(name, tableType) \
+__RF(f1) \
+__RF(f2) \
+__RF(f3) \
+__RF(f4) \
+__RF(f5) \
+TABLE_ROWS_END
 
 #define TABLE6(name, tableType, f1, f2, f3, f4, f5, f6) TABLE_BEGIN(name, tableType) \
 __F(f1) \
@@ -329,7 +415,15 @@ __F(f3) \
 __F(f4) \
 __F(f5) \
 __F(f6) \
-TABLE_END
+TABLE_END \
+TABLE_ROWS_BEGIN(name, tableType) \
+__RF(f1) \
+__RF(f2) \
+__RF(f3) \
+__RF(f4) \
+__RF(f5) \
+__RF(f6) \
+TABLE_ROWS_END
 
 	TABLE5(Module, TableType::MODULE, generation, name, mvid, encid, encBaseId)
 	TABLE3(TypeRef, TableType::TYPEREF, resolutionScope, typeName, typeNamespace)
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "../CommonDef.h"
+#include "MetadataDef.h"
+
+namespace hybridclr
+{
+namespace metadata
+{
+	inline uint32_t PopCount64(uint64_t x)
+	{
+		x = x - ((x >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (uint32_t)((x * 0x0101010101010101ULL) >> 56);
+	}
+
+	// map from a table row index to T for tables where only some rows carry a value.
+	// a presence bitmap with per-word prefix counts locates the value in a dense array, so a lookup is
+	// two array reads and a popcount, and memory is one bit per row plus the values actually present.
+	// rows may be added in any order (the last value wins for a repeated row), Seal must be called before the first lookup.
+	template<typename T>
+	class RowIndexedSparseArray
+	{
+	public:
+		void Add(uint32_t rowIndex, const T& value)
+		{
+			_pendings.push_back({ rowIndex, value });
+		}
+
+		void Seal()
+		{
+			std::stable_sort(_pendings.begin(), _pendings.end(), [](const PendingEntry& a, const PendingEntry& b) { return a.rowIndex < b.rowIndex; });
+			uint32_t wordCount = _pendings.empty() ? 0 : _pendings.back().rowIndex / 64 + 1;
+			_bits.assign(wordCount, 0);
+			_ranks.assign(wordCount, 0);
+			_values.clear();
+			_values.reserve(_pendings.size());
+			for (size_t i = 0; i < _pendings.size(); i++)
+			{
+				const PendingEntry& e = _pendings[i];
+				if (i + 1 < _pendings.size() && _pendings[i + 1].rowIndex == e.rowIndex)
+				{
+					continue;
+				}
+				_bits[e.rowIndex / 64] |= 1ULL << (e.rowIndex % 64);
+				_values.push_back(e.value);
+			}
+			uint32_t rank = 0;
+			for (uint32_t i = 0; i < wordCount; i++)
+			{
+				_ranks[i] = rank;
+				rank += PopCount64(_bits[i]);
+			}
+			std::vector<PendingEntry>().swap(_pendings);
+		}
+
+		const T* Find(uint32_t rowIndex) const
+		{
+			uint32_t wordIndex = rowIndex / 64;
+			if (wordIndex >= (uint32_t)_bits.size())
+			{
+				return nullptr;
+			}
+			uint64_t word = _bits[wordIndex];
+			uint64_t mask = 1ULL << (rowIndex % 64);
+			if (!(word & mask))
+			{
+				return nullptr;
+			}
+			return &_values[_ranks[wordIndex] + PopCount64(word & (mask - 1))];
+		}
+
+		T* Find(uint32_t rowIndex)
+		{
+			return const_cast<T*>(static_cast<const RowIndexedSparseArray*>(this)->Find(rowIndex));
+		}
+
+		uint32_t Size() const { return (uint32_t)_values.size(); }
+
+	private:
+		struct PendingEntry
+		{
+			uint32_t rowIndex;
+			T value;
+		};
+
+		std::vector<uint64_t> _bits;
+		std::vector<uint32_t> _ranks;
+		std::vector<T> _values;
+		std::vector<PendingEntry> _pendings;
+	};
+
+	// RowIndexedSparseArray keyed by metadata token, one per table that appears in the keys
+	template<typename T>
+	class TokenIndexedSparseArray
+	{
+	public:
+		void Add(uint32_t token, const T& value)
+		{
+			uint32_t tableIndex = (uint32_t)DecodeTokenTableType(token);
+			if (tableIndex >= (uint32_t)_tables.size())
+			{
+				_tables.resize(tableIndex + 1);
+			}
+			_tables[tableIndex].Add(DecodeTokenRowIndex(token), value);
+		}
+
+		void Seal()
+		{
+			for (RowIndexedSparseArray<T>& table : _tables)
+			{
+				table.Seal();
+			}
+		}
+
+		const T* Find(uint32_t token) const
+		{
+			uint32_t tableIndex = (uint32_t)DecodeTokenTableType(token);
+			return tableIndex < (uint32_t)_tables.size() ? _tables[tableIndex].Find(DecodeTokenRowIndex(token)) : nullptr;
+		}
+
+		T* Find(uint32_t token)
+		{
+			return const_cast<T*>(static_cast<const TokenIndexedSparseArray*>(this)->Find(token));
+		}
+
+		uint32_t Size() const
+		{
+			uint32_t size = 0;
+			for (const RowIndexedSparseArray<T>& table : _tables)
+			{
+				size += table.Size();
+			}
+			return size;
+		}
+
+	private:
+		std::vector<RowIndexedSparseArray<T>> _tables;
+	};
+}
+}
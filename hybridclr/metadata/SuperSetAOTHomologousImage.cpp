@@ -1,5 +1,7 @@
 #include "SuperSetAOTHomologousImage.h"
 
+#include <algorithm>
+
 #include "vm/MetadataLock.h"
 #include "vm/GlobalMetadata.h"
 #include "vm/Class.h"
@@ -64,54 +66,61 @@ namespace metadata
 	{
 		_defaultIl2CppType = &il2cpp_defaults.missing_class->byval_arg;
 
-		std::vector< SuperSetTypeIntermediateInfo> typeIntermediateInfos;
-		InitTypes0(typeIntermediateInfos);
-		InitNestedClass(typeIntermediateInfos);
-		InitTypes1(typeIntermediateInfos);
-
-		InitMethods(typeIntermediateInfos);
-		InitFields(typeIntermediateInfos);
+		// only index the rows here. types, methods and fields are matched against the aot metadata
+		// the first time they are looked up, most of a supplementary image is never touched.
+		InitTypes0();
+		InitNestedClass();
+		_methodDefs.resize(_rawImage->GetTable(TableType::METHOD).rowNum);
+		_fields.resize(_rawImage->GetTable(TableType::FIELD).rowNum);
 	}
 
-	void SuperSetAOTHomologousImage::InitTypes0(std::vector< SuperSetTypeIntermediateInfo>& typeIntermediateInfos)
+	void SuperSetAOTHomologousImage::InitTypes0()
 	{
 		const Table& typeDefTb = _rawImage->GetTable(TableType::TYPEDEF);
 		uint32_t typeCount = typeDefTb.rowNum;
-		typeIntermediateInfos.resize(typeCount);
-		_typeDefs.resize(typeCount);
-		_aotTypeIndex2TypeDefs.resize(typeCount);
+		// the atomic flags make the type info non-movable, so the vector is built at its final size. value-initialized to zero.
+		std::vector<SuperSetTypeIntermediateInfo>(typeCount).swap(_types);
+		for (uint32_t i = 0; i < typeCount; i++)
+		{
+			TbTypeDef data = _rawImage->ReadTypeDef(i + 1);
+			SuperSetTypeIntermediateInfo& type = _types[i];
+			type.homoMethodStartIndex = data.methodList;
+			type.homoFieldStartIndex = data.fieldList;
+		}
 	}
 
-	void SuperSetAOTHomologousImage::InitNestedClass(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos)
+	void SuperSetAOTHomologousImage::InitNestedClass()
 	{
 		const Table& nestedClassTb = _rawImage->GetTable(TableType::NESTEDCLASS);
 		for (uint32_t i = 0; i < nestedClassTb.rowNum; i++)
 		{
 			TbNestedClass data = _rawImage->ReadNestedClass(i + 1);
-			SuperSetTypeIntermediateInfo& nestedType = typeIntermediateInfos[data.nestedClass - 1];
+			SuperSetTypeIntermediateInfo& nestedType = _types[data.nestedClass - 1];
 			nestedType.homoParentRowIndex = data.enclosingClass;
 		}
 	}
 
-	void SuperSetAOTHomologousImage::InitType(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos, SuperSetTypeIntermediateInfo& type)
+	void SuperSetAOTHomologousImage::InitType(SuperSetTypeIntermediateInfo& type)
 	{
-		if (type.inited)
+		if (type.inited.load(std::memory_order_acquire))
 		{
 			return;
 		}
-		type.inited = true;
-		uint32_t rowIndex = (uint32_t)(&type - &typeIntermediateInfos[0] + 1);
-		TbTypeDef data = _rawImage->ReadTypeDef(rowIndex);
+		FindAotType(type);
+		type.inited.store(true, std::memory_order_release);
+	}
 
-		type.homoMethodStartIndex = data.methodList;
-		type.homoFieldStartIndex = data.fieldList;
+	void SuperSetAOTHomologousImage::FindAotType(SuperSetTypeIntermediateInfo& type)
+	{
+		uint32_t rowIndex = (uint32_t)(&type - &_types[0] + 1);
+		TbTypeDef data = _rawImage->ReadTypeDef(rowIndex);
 
 		const char* name = _rawImage->GetStringFromRawIndex(data.typeName);
 		const char* namespaze = _rawImage->GetStringFromRawIndex(data.typeNamespace);
 		if (type.homoParentRowIndex)
 		{
-			SuperSetTypeIntermediateInfo& parent = typeIntermediateInfos[type.homoParentRowIndex - 1];
-			InitType(typeIntermediateInfos, parent);
+			SuperSetTypeIntermediateInfo& parent = _types[type.homoParentRowIndex - 1];
+			InitType(parent);
 			const Il2CppTypeDefinition* parentTypeDef = parent.aotTypeDef;
 			if (parentTypeDef == nullptr)
 			{
@@ -150,71 +159,101 @@ namespace metadata
 		//RaiseExecutionEngineException(msg);
 	}
 
-	void SuperSetAOTHomologousImage::InitTypes1(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos)
+	void SuperSetAOTHomologousImage::InitTypeMembers(uint32_t typeRowIndex)
 	{
-		for (SuperSetTypeIntermediateInfo& td : typeIntermediateInfos)
+		SuperSetTypeIntermediateInfo& type = _types[typeRowIndex - 1];
+		if (type.membersInited.load(std::memory_order_acquire))
 		{
-			//uint32_t rowIndex = ++index;
-			//TbTypeDef data = _rawImage->ReadTypeDef(rowIndex);
-
-			//td.inited = false;
-			//td.homoParentRowIndex = 0;
-			//td.homoRowIndex = rowIndex;
-			//td.homoMethodStartIndex = data.methodList;
-			//td.homoFieldStartIndex = data.fieldList;
-
-			//td.name = _rawImage->GetStringFromRawIndex(data.typeName);
-			//td.namespaze = _rawImage->GetStringFromRawIndex(data.typeNamespace);
-			InitType(typeIntermediateInfos, td);
+			return;
 		}
+		InitType(type);
+		InitMethods(typeRowIndex, type);
+		InitFields(typeRowIndex, type);
+		type.membersInited.store(true, std::memory_order_release);
+	}
 
-		uint32_t index = 0;
-		for (SuperSetTypeIntermediateInfo& td : typeIntermediateInfos)
+	void SuperSetAOTHomologousImage::InitGenericTypeMembers()
+	{
+		if (_genericTypeMembersInited.load(std::memory_order_acquire))
 		{
-			SuperSetTypeDefDetail& type = _typeDefs[index++];
-			type.aotIl2CppType = td.aotIl2CppType;
-			if (td.aotTypeDef)
-			{
-				_aotTypeIndex2TypeDefs[il2cpp::vm::GlobalMetadata::GetIndexForTypeDefinition(td.aotTypeDef)] = &type;
-			}
+			return;
 		}
+		// GetMethodBody is keyed by the aot token, which can't be mapped back to a row without matching.
+		// only generic methods and methods of generic types are ever asked for, so match just the types owning generic parameters.
+		const Table& tb = _rawImage->GetTable(TableType::GENERICPARAM);
+		for (uint32_t i = 0; i < tb.rowNum; i++)
+		{
+			TbGenericParam data = _rawImage->ReadGenericParam(i + 1);
+			TableType ownerType = DecodeTypeOrMethodDefCodedIndexTableType(data.owner);
+			uint32_t ownerIndex = DecodeTypeOrMethodDefCodedIndexRowIndex(data.owner);
+			IL2CPP_ASSERT(ownerIndex > 0);
+			InitTypeMembers(ownerType == TableType::TYPEDEF ? ownerIndex : FindDeclaringTypeRowIndex(ownerIndex, &SuperSetTypeIntermediateInfo::homoMethodStartIndex));
+		}
+		_genericTypeMembersInited.store(true, std::memory_order_release);
 	}
 
-	void SuperSetAOTHomologousImage::InitMethods(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos)
+	const SuperSetTypeIntermediateInfo& SuperSetAOTHomologousImage::GetInitedType(uint32_t typeRowIndex)
 	{
-		const Table& methodTb = _rawImage->GetTable(TableType::METHOD);
-		uint32_t methodCount = methodTb.rowNum;
-		_methodDefs.resize(methodCount);
-		//_token2MethodDefs.resize(methodCount * 2);
-		uint32_t typeCount = (uint32_t)typeIntermediateInfos.size();
-		for (SuperSetTypeIntermediateInfo& type : typeIntermediateInfos)
+		SuperSetTypeIntermediateInfo& type = _types[typeRowIndex - 1];
+		if (!type.inited.load(std::memory_order_acquire))
 		{
-			uint32_t nextTypeIndex = (uint32_t)(&type - &typeIntermediateInfos[0] + 1);
-			uint32_t nextTypeMethodStartIndex = nextTypeIndex < typeCount ? typeIntermediateInfos[nextTypeIndex].homoMethodStartIndex : methodCount + 1;
+			il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
+			InitType(type);
+		}
+		return type;
+	}
 
+	void SuperSetAOTHomologousImage::EnsureTypeMembersInited(uint32_t typeRowIndex)
+	{
+		if (!_types[typeRowIndex - 1].membersInited.load(std::memory_order_acquire))
+		{
+			il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
+			InitTypeMembers(typeRowIndex);
+		}
+	}
+
+	uint32_t SuperSetAOTHomologousImage::FindDeclaringTypeRowIndex(uint32_t memberRowIndex, uint32_t SuperSetTypeIntermediateInfo::* memberStartIndex) const
+	{
+		// member lists of typedef rows are ascending, the owner is the last type starting at or before the member
+		auto it = std::upper_bound(_types.begin(), _types.end(), memberRowIndex,
+			[memberStartIndex](uint32_t rowIndex, const SuperSetTypeIntermediateInfo& type) { return rowIndex < type.*memberStartIndex; });
+		IL2CPP_ASSERT(it != _types.begin());
+		return (uint32_t)(it - _types.begin());
+	}
 
-			for (uint32_t i = type.homoMethodStartIndex; i < nextTypeMethodStartIndex ; i++)
+	void SuperSetAOTHomologousImage::InitMethods(uint32_t typeRowIndex, SuperSetTypeIntermediateInfo& type)
+	{
+		if (type.aotTypeDef == nullptr)
+		{
+			return;
+		}
+		uint32_t methodCount = (uint32_t)_methodDefs.size();
+		uint32_t typeCount = (uint32_t)_types.size();
+		uint32_t nextTypeMethodStartIndex = typeRowIndex < typeCount ? _types[typeRowIndex].homoMethodStartIndex : methodCount + 1;
+		for (uint32_t i = type.homoMethodStartIndex; i < nextTypeMethodStartIndex ; i++)
+		{
+			SuperSetMethodDefDetail& method = _methodDefs[i - 1];
+			TbMethod data = _rawImage->ReadMethod(i);
+			//method.declaringTypeDef = type.aotTypeDef;
+			//method.name = _rawImage->GetStringFromRawIndex(data.name);
+			MethodRefSig signature = {};
+			signature.flags = data.flags;
+			BlobReader methodSigReader = _rawImage->GetBlobReaderByRawIndex(data.signature);
+			ReadMethodDefSig(methodSigReader, signature);
+			const char* methodName = _rawImage->GetStringFromRawIndex(data.name);
+			method.aotMethodDef = FindMatchMethod(type.aotTypeDef, method, methodName, signature);
+			// every such method is registered by InitGenericTypeMembers. once it finished, GetMethodBody reads the
+			// array without the lock, so it must not be resized anymore.
+			if (method.aotMethodDef && !_genericTypeMembersInited.load(std::memory_order_relaxed) &&
+				(type.aotTypeDef->genericContainerIndex != kGenericContainerIndexInvalid
+					|| method.aotMethodDef->genericContainerIndex != kGenericContainerIndexInvalid))
 			{
-				SuperSetMethodDefDetail& method = _methodDefs[i - 1];
-				TbMethod data = _rawImage->ReadMethod(i);
-				//method.declaringTypeDef = type.aotTypeDef;
-				//method.name = _rawImage->GetStringFromRawIndex(data.name);
-				if (type.aotTypeDef == nullptr)
+				uint32_t aotRowIndex = DecodeTokenRowIndex(method.aotMethodDef->token);
+				if (aotRowIndex >= (uint32_t)_aotMethodRowIndex2MethodDefs.size())
 				{
-					continue;
-				}
-				MethodRefSig signature = {};
-				signature.flags = data.flags;
-				BlobReader methodSigReader = _rawImage->GetBlobReaderByRawIndex(data.signature);
-				ReadMethodDefSig(methodSigReader, signature);
-				const char* methodName = _rawImage->GetStringFromRawIndex(data.name);
-				method.aotMethodDef = FindMatchMethod(type.aotTypeDef, method, methodName, signature);
-				if (method.aotMethodDef &&
-					(type.aotTypeDef->genericContainerIndex != kGenericContainerIndexInvalid
-						|| method.aotMethodDef->genericContainerIndex != kGenericContainerIndexInvalid))
-				{
-					_token2MethodDefs[method.aotMethodDef->token] = &method;
+					_aotMethodRowIndex2MethodDefs.resize(aotRowIndex + 1, nullptr);
 				}
+				_aotMethodRowIndex2MethodDefs[aotRowIndex] = &method;
 			}
 		}
 	}
@@ -244,55 +283,53 @@ namespace metadata
 		IL2CPP_ASSERT(readParamNum == (int)paramCount);
 	}
 
-	void SuperSetAOTHomologousImage::InitFields(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos)
+	void SuperSetAOTHomologousImage::InitFields(uint32_t typeRowIndex, SuperSetTypeIntermediateInfo& type)
 	{
-		const Table& fieldTb = _rawImage->GetTable(TableType::FIELD);
-		uint32_t fieldCount = fieldTb.rowNum;
-		_fields.resize(fieldTb.rowNum);
-
-		uint32_t typeCount = (uint32_t)typeIntermediateInfos.size();
-		for (SuperSetTypeIntermediateInfo& type : typeIntermediateInfos)
+		uint32_t fieldCount = (uint32_t)_fields.size();
+		uint32_t typeCount = (uint32_t)_types.size();
+		uint32_t nextTypeFieldStartIndex = typeRowIndex < typeCount ? _types[typeRowIndex].homoFieldStartIndex : fieldCount + 1;
+		for (uint32_t i = type.homoFieldStartIndex; i < nextTypeFieldStartIndex; i++)
 		{
-			uint32_t nextTypeIndex = (uint32_t)(&type - &typeIntermediateInfos[0] + 1);
-			uint32_t nextTypeFieldStartIndex = nextTypeIndex < typeCount ? typeIntermediateInfos[nextTypeIndex].homoFieldStartIndex : fieldCount + 1;
-			for (uint32_t i = type.homoFieldStartIndex; i < nextTypeFieldStartIndex; i++)
+			SuperSetFieldDefDetail& field = _fields[i - 1];
+			//field.homoRowIndex = i;
+			TbField data = _rawImage->ReadField(i);
+			//field.name = _rawImage->GetStringFromRawIndex(data.name);
+
+			//field.declaringTypeDef = type.aotTypeDef;
+			field.declaringIl2CppType = type.aotIl2CppType;
+			if (type.aotTypeDef == nullptr)
 			{
-				SuperSetFieldDefDetail& field = _fields[i - 1];
-				//field.homoRowIndex = i;
-				TbField data = _rawImage->ReadField(i);
-				//field.name = _rawImage->GetStringFromRawIndex(data.name);
-
-				//field.declaringTypeDef = type.aotTypeDef;
-				field.declaringIl2CppType = type.aotIl2CppType;
-				if (type.aotTypeDef == nullptr)
-				{
-					continue;
-				}
-
-				BlobReader br = _rawImage->GetBlobReaderByRawIndex(data.signature);
-				FieldRefSig frs;
-				ReadFieldRefSig(br, nullptr, frs);
-				if (data.flags)
-				{
-					Il2CppType* newType = MetadataPool::ShallowCloneIl2CppType(frs.type);
-					newType->attrs = data.flags;
-					frs.type = newType;
-				}
+				continue;
+			}
 
-				const char* fieldName = _rawImage->GetStringFromRawIndex(data.name);
-				field.aotFieldDef = FindMatchField(type.aotTypeDef, field, fieldName, frs.type);
+			BlobReader br = _rawImage->GetBlobReaderByRawIndex(data.signature);
+			FieldRefSig frs;
+			ReadFieldRefSig(br, nullptr, frs);
+			if (data.flags)
+			{
+				Il2CppType* newType = MetadataPool::ShallowCloneIl2CppType(frs.type);
+				newType->attrs = data.flags;
+				frs.type = newType;
 			}
+
+			const char* fieldName = _rawImage->GetStringFromRawIndex(data.name);
+			field.aotFieldDef = FindMatchField(type.aotTypeDef, field, fieldName, frs.type);
 		}
 	}
 
 	MethodBody* SuperSetAOTHomologousImage::GetMethodBody(uint32_t token)
 	{
-		auto it = _token2MethodDefs.find(token);
-		if (it == _token2MethodDefs.end())
+		if (!_genericTypeMembersInited.load(std::memory_order_acquire))
+		{
+			il2cpp::os::FastAutoLock lock(&il2cpp::vm::g_MetadataLock);
+			InitGenericTypeMembers();
+		}
+		uint32_t aotRowIndex = DecodeTokenRowIndex(token);
+		SuperSetMethodDefDetail* method = aotRowIndex < (uint32_t)_aotMethodRowIndex2MethodDefs.size() ? _aotMethodRowIndex2MethodDefs[aotRowIndex] : nullptr;
+		if (method == nullptr)
 		{
 			return nullptr;
 		}
-		SuperSetMethodDefDetail* method = it->second;
 		uint32_t rowIndex = (uint32_t)(method - &_methodDefs[0] + 1);
 		TbMethod methodData = _rawImage->ReadMethod(rowIndex);
 		MethodBody* body = new (HYBRIDCLR_MALLOC_ZERO(sizeof(MethodBody))) MethodBody();
@@ -302,8 +339,8 @@ namespace metadata
 
 	const Il2CppType* SuperSetAOTHomologousImage::GetIl2CppTypeFromRawTypeDefIndex(uint32_t index)
 	{
-		IL2CPP_ASSERT((size_t)index < _typeDefs.size());
-		return _typeDefs[index].aotIl2CppType;
+		IL2CPP_ASSERT((size_t)index < _types.size());
+		return GetInitedType(index + 1).aotIl2CppType;
 	}
 
 	Il2CppGenericContainer* SuperSetAOTHomologousImage::GetGenericContainerByRawIndex(uint32_t index)
@@ -313,23 +350,15 @@ namespace metadata
 
 	Il2CppGenericContainer* SuperSetAOTHomologousImage::GetGenericContainerByTypeDefRawIndex(int32_t typeDefIndex)
 	{
-		auto it = _aotTypeIndex2TypeDefs.find(typeDefIndex);
-		if (it == _aotTypeIndex2TypeDefs.end())
-		{
-			return nullptr;
-		}
-		const Il2CppType* type = it->second->aotIl2CppType;
-		if (type == nullptr)
-		{
-			return nullptr;
-		}
-		const Il2CppTypeDefinition* typeDef = (const Il2CppTypeDefinition*)(type->data.typeHandle);
-		return (Il2CppGenericContainer*)il2cpp::vm::GlobalMetadata::GetGenericContainerFromIndex(typeDef->genericContainerIndex);
+		// typeDefIndex is the declaring type of a matched aot method, see ReadMethodBody
+		Il2CppTypeDefinition* type = (Il2CppTypeDefinition*)il2cpp::vm::GlobalMetadata::GetTypeHandleFromIndex(typeDefIndex);
+		return (Il2CppGenericContainer*)il2cpp::vm::GlobalMetadata::GetGenericContainerFromIndex(type->genericContainerIndex);
 	}
 
 	const Il2CppMethodDefinition* SuperSetAOTHomologousImage::GetMethodDefinitionFromRawIndex(uint32_t index)
 	{
 		IL2CPP_ASSERT((size_t)index < _methodDefs.size());
+		EnsureTypeMembersInited(FindDeclaringTypeRowIndex(index + 1, &SuperSetTypeIntermediateInfo::homoMethodStartIndex));
 		SuperSetMethodDefDetail& method = _methodDefs[index];
 		const Il2CppMethodDefinition* methodDef = method.aotMethodDef;
 		if (!methodDef)
@@ -343,12 +372,13 @@ namespace metadata
 	void SuperSetAOTHomologousImage::ReadFieldRefInfoFromFieldDefToken(uint32_t rowIndex, FieldRefInfo& ret)
 	{
 		IL2CPP_ASSERT(rowIndex > 0);
+		EnsureTypeMembersInited(FindDeclaringTypeRowIndex(rowIndex, &SuperSetTypeIntermediateInfo::homoFieldStartIndex));
 		SuperSetFieldDefDetail& fd = _fields[rowIndex - 1];
 		ret.containerType = fd.declaringIl2CppType;
 		ret.field = fd.aotFieldDef;
 	}
 
-	const Il2CppType* SuperSetAOTHomologousImage::ReadTypeFromResolutionScope(uint32_t scope, uint32_t typeNamespace, uint32_t typeName)
+	const Il2CppType* SuperSetAOTHomologousImage::ReadTypeFromResolutionScope(uint32_t scope, uint32_t typeNamespace, uint32_t typeName, bool raiseExceptionIfNotFound)
 	{
 		TableType tokenType;
 		uint32_t rawIndex;
@@ -362,6 +392,10 @@ namespace metadata
 		}
 		case TableType::MODULEREF:
 		{
+			if (!raiseExceptionIfNotFound)
+			{
+				return nullptr;
+			}
 			RaiseNotSupportedException("Image::ReadTypeFromResolutionScope not support ResolutionScore.MODULEREF");
 			return nullptr;
 		}
@@ -372,7 +406,11 @@ namespace metadata
 		}
 		case TableType::TYPEREF:
 		{
-			const Il2CppType* enClosingType = ReadTypeFromTypeRef(rawIndex);
+			const Il2CppType* enClosingType = ReadTypeFromTypeRef(rawIndex, raiseExceptionIfNotFound);
+			if (!enClosingType)
+			{
+				return nullptr;
+			}
 			IL2CPP_ASSERT(typeNamespace == 0);
 			const char* name = _rawImage->GetStringFromRawIndex(typeName);
 
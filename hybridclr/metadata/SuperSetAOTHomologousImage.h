@@ -1,7 +1,8 @@
 #pragma once
 
+#include <atomic>
+
 #include "AOTHomologousImage.h"
-#include "utils/Il2CppHashMap.h"
 #include "utils/HashUtils.h"
 
 namespace hybridclr
@@ -9,9 +10,12 @@ namespace hybridclr
 	namespace metadata
 	{
 
+		// resolved lazily, only the typedef rows and the nesting are read at load.
+		// the flags are stored with release after the data they guard and read with acquire by lock-free lookups.
 		struct SuperSetTypeIntermediateInfo
 		{
-			bool inited;
+			std::atomic<bool> inited; // aotTypeDef and aotIl2CppType are resolved
+			std::atomic<bool> membersInited; // methods and fields of the type are resolved
 			//uint32_t homoRowIndex;
 			uint32_t homoParentRowIndex;
 			uint32_t homoMethodStartIndex; // start from 1
@@ -24,21 +28,6 @@ namespace hybridclr
 			//const Il2CppClass* aotKlass;
 		};
 
-		struct SuperSetTypeDefDetail
-		{
-			//bool inited;
-			//uint32_t homoRowIndex;
-			//uint32_t homoParentRowIndex;
-			//uint32_t homoMethodStartIndex; // start from 1
-			//uint32_t homoFieldStartIndex; // start from 1
-			//const char* name;
-			//const char* namespaze;
-			//int32_t aotTypeIndex; // il2cpp type index
-			const Il2CppType* aotIl2CppType;
-			//const Il2CppTypeDefinition* aotTypeDef;
-			//const Il2CppClass* aotKlass;
-		};
-
 		struct SuperSetMethodDefDetail
 		{
 			//uint32_t homoRowIndex; 
@@ -62,11 +51,11 @@ namespace hybridclr
 		class SuperSetAOTHomologousImage : public AOTHomologousImage
 		{
 		public:
-			SuperSetAOTHomologousImage() : AOTHomologousImage() {}
+			SuperSetAOTHomologousImage() : AOTHomologousImage(), _genericTypeMembersInited(false) {}
 
 			void InitRuntimeMetadatas() override;
 
-			const Il2CppType* ReadTypeFromResolutionScope(uint32_t scope, uint32_t typeNamespace, uint32_t typeName) override;
+			const Il2CppType* ReadTypeFromResolutionScope(uint32_t scope, uint32_t typeNamespace, uint32_t typeName, bool raiseExceptionIfNotFound) override;
 			MethodBody* GetMethodBody(uint32_t token) override;
 			const Il2CppType* GetIl2CppTypeFromRawTypeDefIndex(uint32_t index) override;
 			Il2CppGenericContainer* GetGenericContainerByRawIndex(uint32_t index) override;
@@ -75,20 +64,28 @@ namespace hybridclr
 			void ReadFieldRefInfoFromFieldDefToken(uint32_t rowIndex, FieldRefInfo& ret) override;
 		private:
 
-			void InitTypes0(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos);
-			void InitNestedClass(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos);
-			void InitType(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos, SuperSetTypeIntermediateInfo& type);
-			void InitTypes1(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos);
+			void InitTypes0();
+			void InitNestedClass();
+			void InitType(SuperSetTypeIntermediateInfo& type);
+			void FindAotType(SuperSetTypeIntermediateInfo& type);
+			void InitTypeMembers(uint32_t typeRowIndex);
+			void InitGenericTypeMembers();
 			void ReadMethodDefSig(BlobReader& reader, MethodRefSig& method);
-			void InitMethods(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos);
-			void InitFields(std::vector<SuperSetTypeIntermediateInfo>& typeIntermediateInfos);
+			void InitMethods(uint32_t typeRowIndex, SuperSetTypeIntermediateInfo& type);
+			void InitFields(uint32_t typeRowIndex, SuperSetTypeIntermediateInfo& type);
+
+			const SuperSetTypeIntermediateInfo& GetInitedType(uint32_t typeRowIndex);
+			void EnsureTypeMembersInited(uint32_t typeRowIndex);
+			uint32_t FindDeclaringTypeRowIndex(uint32_t memberRowIndex, uint32_t SuperSetTypeIntermediateInfo::* memberStartIndex) const;
 
 			const Il2CppType* _defaultIl2CppType;
 
-			std::vector<SuperSetTypeDefDetail> _typeDefs;
-			Il2CppHashMap<int32_t, SuperSetTypeDefDetail*, il2cpp::utils::PassThroughHash<int32_t>> _aotTypeIndex2TypeDefs;
+			std::vector<SuperSetTypeIntermediateInfo> _types;
 
-			Il2CppHashMap<uint32_t, SuperSetMethodDefDetail*, il2cpp::utils::PassThroughHash<uint32_t>> _token2MethodDefs;
+			// indexed by row index of the aot method token, only generic methods or methods of generic types are set.
+			// filled for all such methods the first time GetMethodBody is called.
+			std::atomic<bool> _genericTypeMembersInited;
+			std::vector<SuperSetMethodDefDetail*> _aotMethodRowIndex2MethodDefs;
 			std::vector<SuperSetMethodDefDetail> _methodDefs;
 
 			std::vector<SuperSetFieldDefDetail> _fields;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../CommonDef.h"
+#include "../metadata/MetadataUtil.h"
+#include "../metadata/Opcodes.h"
+
+namespace hybridclr
+{
+namespace transform
+{
+	// local variable index an IL instruction reads, writes or takes the address of, -1 for other instructions.
+
+	inline int32_t GetLdlocIndex(const metadata::OpCodeInfo* oc, const byte* operand)
+	{
+		switch (oc->id)
+		{
+		case metadata::OpcodeEnum::LDLOC_0: return 0;
+		case metadata::OpcodeEnum::LDLOC_1: return 1;
+		case metadata::OpcodeEnum::LDLOC_2: return 2;
+		case metadata::OpcodeEnum::LDLOC_3: return 3;
+		case metadata::OpcodeEnum::LDLOC_S: return operand[0];
+		case metadata::OpcodeEnum::LDLOC: return metadata::GetU2LittleEndian(operand);
+		default: return -1;
+		}
+	}
+
+	inline int32_t GetStlocIndex(const metadata::OpCodeInfo* oc, const byte* operand)
+	{
+		switch (oc->id)
+		{
+		case metadata::OpcodeEnum::STLOC_0: return 0;
+		case metadata::OpcodeEnum::STLOC_1: return 1;
+		case metadata::OpcodeEnum::STLOC_2: return 2;
+		case metadata::OpcodeEnum::STLOC_3: return 3;
+		case metadata::OpcodeEnum::STLOC_S: return operand[0];
+		case metadata::OpcodeEnum::STLOC: return metadata::GetU2LittleEndian(operand);
+		default: return -1;
+		}
+	}
+
+	inline int32_t GetLdlocaIndex(const metadata::OpCodeInfo* oc, const byte* operand)
+	{
+		switch (oc->id)
+		{
+		case metadata::OpcodeEnum::LDLOCA_S: return operand[0];
+		case metadata::OpcodeEnum::LDLOCA: return metadata::GetU2LittleEndian(operand);
+		default: return -1;
+		}
+	}
+}
+}
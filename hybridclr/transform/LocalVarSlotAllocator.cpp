@@ -0,0 +1,422 @@
+#include "LocalVarSlotAllocator.h"
+
+#include <algorithm>
+
+#include "../metadata/MetadataUtil.h"
+
+#include "LocalVarOpcodes.h"
+
+using namespace hybridclr::metadata;
+
+namespace hybridclr
+{
+namespace transform
+{
+	// interference matrix is localCount * localCount, methods with more locals keep one slot per local.
+	constexpr int32_t kMaxSharedSlotLocalCount = 256;
+
+	static bool SetTest(const std::vector<uint64_t>& set, int32_t idx)
+	{
+		return (set[idx >> 6] >> (idx & 63)) & 1;
+	}
+
+	static void SetAdd(std::vector<uint64_t>& set, int32_t idx)
+	{
+		set[idx >> 6] |= (uint64_t)1 << (idx & 63);
+	}
+
+	static void SetRemove(std::vector<uint64_t>& set, int32_t idx)
+	{
+		set[idx >> 6] &= ~((uint64_t)1 << (idx & 63));
+	}
+
+	static void SetUnion(std::vector<uint64_t>& dst, const std::vector<uint64_t>& src)
+	{
+		for (size_t i = 0; i < dst.size(); i++)
+		{
+			dst[i] |= src[i];
+		}
+	}
+
+	void LocalVarSlotAllocator::AllocateOwnSlotGroups()
+	{
+		_slotGroups.resize(_localCount);
+		for (int32_t i = 0; i < _localCount; i++)
+		{
+			_slotGroups[i] = i;
+		}
+		_slotGroupCount = _localCount;
+		_zeroInitLocals.assign(_localCount, true);
+	}
+
+	bool LocalVarSlotAllocator::DecodeInstructions()
+	{
+		const byte* ilcodeStart = _body.ilcodes;
+		const byte* codeEnd = ilcodeStart + _body.codeSize;
+		const byte* ip = ilcodeStart;
+
+		while (ip < codeEnd)
+		{
+			uint32_t offset = (uint32_t)(ip - ilcodeStart);
+			const OpCodeInfo* oc = DecodeOpCodeInfo(ip, codeEnd);
+			if (!oc)
+			{
+				return false;
+			}
+			int32_t opCodeSize = GetOpCodeSize(ip, oc);
+			const byte* operand = ip + 1;
+			int32_t useLocal = GetLdlocIndex(oc, operand);
+			int32_t defLocal = GetStlocIndex(oc, operand);
+			int32_t addressTakenLocal = GetLdlocaIndex(oc, operand);
+			if (useLocal >= _localCount || defLocal >= _localCount || addressTakenLocal >= _localCount)
+			{
+				return false;
+			}
+			if (addressTakenLocal >= 0)
+			{
+				_unshareableLocals[addressTakenLocal] = true;
+				// the address may be read through at any later point, count it as a use
+				useLocal = addressTakenLocal;
+			}
+			_insts.push_back({ offset, oc, operand, useLocal, defLocal });
+			ip += opCodeSize;
+		}
+		if (ip != codeEnd)
+		{
+			return false;
+		}
+		// `ldloca x; initobj` overwrites the whole of x before anything can read it
+		for (size_t i = 0; i + 1 < _insts.size(); i++)
+		{
+			ILInst& inst = _insts[i];
+			const ILInst& next = _insts[i + 1];
+			if (GetLdlocaIndex(inst.oc, inst.operand) >= 0 && next.oc->id == OpcodeEnum::INITOBJ
+				&& _splitOffsets.find(next.offset) == _splitOffsets.end())
+			{
+				inst.defLocal = inst.useLocal;
+				inst.useLocal = -1;
+			}
+		}
+		return true;
+	}
+
+	int32_t LocalVarSlotAllocator::FindBlockIndex(uint32_t offset) const
+	{
+		auto it = std::lower_bound(_blocks.begin(), _blocks.end(), offset, [](const ILBlock& block, uint32_t off) { return block.beginOffset < off; });
+		return it != _blocks.end() && it->beginOffset == offset ? (int32_t)(it - _blocks.begin()) : -1;
+	}
+
+	bool LocalVarSlotAllocator::BuildBlocks()
+	{
+		size_t setWordCount = (_localCount + 63) / 64;
+		uint32_t beginOffset = 0;
+		uint32_t instIdx = 0;
+		for (uint32_t endOffset : _splitOffsets)
+		{
+			if (endOffset == beginOffset)
+			{
+				continue;
+			}
+			ILBlock block = {};
+			block.beginOffset = beginOffset;
+			block.endOffset = endOffset;
+			block.firstInst = instIdx;
+			while (instIdx < _insts.size() && _insts[instIdx].offset < endOffset)
+			{
+				++instIdx;
+			}
+			block.endInst = instIdx;
+			if (block.firstInst == block.endInst)
+			{
+				return false;
+			}
+			block.gen.resize(setWordCount);
+			block.kill.resize(setWordCount);
+			block.liveIn.resize(setWordCount);
+			block.liveOut.resize(setWordCount);
+			for (uint32_t i = block.firstInst; i < block.endInst; i++)
+			{
+				const ILInst& inst = _insts[i];
+				if (inst.useLocal >= 0 && !SetTest(block.kill, inst.useLocal))
+				{
+					SetAdd(block.gen, inst.useLocal);
+				}
+				if (inst.defLocal >= 0)
+				{
+					SetAdd(block.kill, inst.defLocal);
+				}
+			}
+			_blocks.push_back(std::move(block));
+			beginOffset = endOffset;
+		}
+		if (_blocks.empty() || beginOffset != _body.codeSize)
+		{
+			return false;
+		}
+
+		// leave jumps through finally blocks, so every endfinally/endfilter may continue at any leave target or handler.
+		std::vector<uint32_t> ehExitTargets;
+		for (const ExceptionClause& eh : _body.exceptionClauses)
+		{
+			int32_t handlerBlock = FindBlockIndex(eh.handlerOffsets);
+			if (handlerBlock < 0)
+			{
+				return false;
+			}
+			ehExitTargets.push_back(handlerBlock);
+			int32_t filterBlock = -1;
+			if (eh.flags == CorILExceptionClauseType::Filter)
+			{
+				filterBlock = FindBlockIndex(eh.classTokenOrFilterOffset);
+				if (filterBlock < 0)
+				{
+					return false;
+				}
+				ehExitTargets.push_back(filterBlock);
+			}
+			for (ILBlock& block : _blocks)
+			{
+				if (block.beginOffset >= eh.tryOffset && block.endOffset <= eh.tryOffset + eh.tryLength)
+				{
+					block.handlers.push_back(handlerBlock);
+					if (filterBlock >= 0)
+					{
+						block.handlers.push_back(filterBlock);
+					}
+				}
+			}
+		}
+		for (const ILInst& inst : _insts)
+		{
+			if (inst.oc->id == OpcodeEnum::LEAVE || inst.oc->id == OpcodeEnum::LEAVE_S)
+			{
+				int32_t brOffset = inst.oc->inlineParam == 1 ? GetI1(inst.operand) : GetI4LittleEndian(inst.operand);
+				int32_t targetBlock = FindBlockIndex(inst.offset + inst.oc->inlineParam + 1 + brOffset);
+				if (targetBlock < 0)
+				{
+					return false;
+				}
+				ehExitTargets.push_back(targetBlock);
+			}
+		}
+
+		for (uint32_t blockIdx = 0; blockIdx < _blocks.size(); blockIdx++)
+		{
+			ILBlock& block = _blocks[blockIdx];
+			const ILInst& last = _insts[block.endInst - 1];
+			uint32_t nextOffset = block.endOffset;
+			bool fallThrough = true;
+			if (last.oc->id == OpcodeEnum::ENDFINALLY || last.oc->id == OpcodeEnum::ENDFILTER)
+			{
+				block.succs = ehExitTargets;
+				fallThrough = false;
+			}
+			else if (last.oc->flow == FlowType::Return || last.oc->flow == FlowType::Throw)
+			{
+				fallThrough = false;
+			}
+			else if (last.oc->inlineType == ArgType::BranchTarget)
+			{
+				int32_t brOffset = last.oc->inlineParam == 1 ? GetI1(last.operand) : GetI4LittleEndian(last.operand);
+				int32_t targetBlock = FindBlockIndex(nextOffset + brOffset);
+				if (targetBlock < 0)
+				{
+					return false;
+				}
+				block.succs.push_back(targetBlock);
+				fallThrough = last.oc->flow != FlowType::Branch;
+			}
+			else if (last.oc->inlineType == ArgType::Switch)
+			{
+				uint32_t caseNum = GetI4LittleEndian(last.operand);
+				for (uint32_t caseIdx = 0; caseIdx < caseNum; caseIdx++)
+				{
+					int32_t targetBlock = FindBlockIndex(nextOffset + GetI4LittleEndian(last.operand + 4 + caseIdx * 4));
+					if (targetBlock < 0)
+					{
+						return false;
+					}
+					block.succs.push_back(targetBlock);
+				}
+			}
+			if (fallThrough && nextOffset < _body.codeSize)
+			{
+				block.succs.push_back(blockIdx + 1);
+			}
+		}
+		return true;
+	}
+
+	void LocalVarSlotAllocator::ComputeLiveness()
+	{
+		size_t setWordCount = (_localCount + 63) / 64;
+		LocalVarSet liveOut(setWordCount);
+		LocalVarSet liveIn(setWordCount);
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (size_t blockIdx = _blocks.size(); blockIdx-- > 0;)
+			{
+				ILBlock& block = _blocks[blockIdx];
+				std::fill(liveOut.begin(), liveOut.end(), 0);
+				for (uint32_t succ : block.succs)
+				{
+					SetUnion(liveOut, _blocks[succ].liveIn);
+				}
+				for (size_t i = 0; i < setWordCount; i++)
+				{
+					liveIn[i] = block.gen[i] | (liveOut[i] & ~block.kill[i]);
+				}
+				// an exception may be thrown before any store in the block, so handler inputs are live through the whole block
+				for (uint32_t handler : block.handlers)
+				{
+					SetUnion(liveIn, _blocks[handler].liveIn);
+				}
+				if (liveIn != block.liveIn || liveOut != block.liveOut)
+				{
+					block.liveIn = liveIn;
+					block.liveOut = liveOut;
+					changed = true;
+				}
+			}
+		}
+	}
+
+	void LocalVarSlotAllocator::AddInterference(int32_t a, int32_t b)
+	{
+		_interferences[a * _localCount + b] = true;
+		_interferences[b * _localCount + a] = true;
+	}
+
+	void LocalVarSlotAllocator::ComputeInterferences()
+	{
+		_interferences.assign(_localCount * _localCount, false);
+		size_t setWordCount = (_localCount + 63) / 64;
+		LocalVarSet handlerLive(setWordCount);
+		LocalVarSet live(setWordCount);
+		for (ILBlock& block : _blocks)
+		{
+			std::fill(handlerLive.begin(), handlerLive.end(), 0);
+			for (uint32_t handler : block.handlers)
+			{
+				SetUnion(handlerLive, _blocks[handler].liveIn);
+			}
+			live = block.liveOut;
+			SetUnion(live, handlerLive);
+			for (uint32_t instIdx = block.endInst; instIdx-- > block.firstInst;)
+			{
+				const ILInst& inst = _insts[instIdx];
+				if (inst.defLocal >= 0)
+				{
+					for (int32_t i = 0; i < _localCount; i++)
+					{
+						if (i != inst.defLocal && SetTest(live, i))
+						{
+							AddInterference(i, inst.defLocal);
+						}
+					}
+					SetRemove(live, inst.defLocal);
+					SetUnion(live, handlerLive);
+				}
+				if (inst.useLocal >= 0)
+				{
+					SetAdd(live, inst.useLocal);
+				}
+			}
+		}
+		// locals read before any store rely on InitLocals, they are all alive at method entry.
+		const LocalVarSet& entryLive = _blocks[0].liveIn;
+		for (int32_t i = 0; i < _localCount; i++)
+		{
+			if (!SetTest(entryLive, i))
+			{
+				continue;
+			}
+			for (int32_t j = i + 1; j < _localCount; j++)
+			{
+				if (SetTest(entryLive, j))
+				{
+					AddInterference(i, j);
+				}
+			}
+		}
+	}
+
+	void LocalVarSlotAllocator::ComputeZeroInitLocals()
+	{
+		// a local alive at method entry may be read before any store on some path.
+		// pinned locals are reported to the gc as-is and always get cleared.
+		const LocalVarSet& entryLive = _blocks[0].liveIn;
+		_zeroInitLocals.resize(_localCount);
+		for (int32_t i = 0; i < _localCount; i++)
+		{
+			_zeroInitLocals[i] = SetTest(entryLive, i) || _body.localVars[i]->pinned;
+		}
+	}
+
+	void LocalVarSlotAllocator::Allocate()
+	{
+		if (_localCount == 0 || _localCount > kMaxSharedSlotLocalCount)
+		{
+			AllocateOwnSlotGroups();
+			return;
+		}
+		_unshareableLocals.assign(_localCount, false);
+		for (int32_t i = 0; i < _localCount; i++)
+		{
+			if (_body.localVars[i]->pinned)
+			{
+				_unshareableLocals[i] = true;
+			}
+		}
+		if (!DecodeInstructions() || !BuildBlocks())
+		{
+			AllocateOwnSlotGroups();
+			return;
+		}
+		ComputeLiveness();
+		ComputeInterferences();
+		ComputeZeroInitLocals();
+
+		std::vector<std::vector<int32_t>> groupMembers;
+		std::vector<bool> groupShareable;
+		_slotGroups.resize(_localCount);
+		for (int32_t local = 0; local < _localCount; local++)
+		{
+			int32_t group = -1;
+			if (!_unshareableLocals[local])
+			{
+				for (size_t g = 0; g < groupMembers.size() && group < 0; g++)
+				{
+					if (!groupShareable[g])
+					{
+						continue;
+					}
+					bool interfered = false;
+					for (int32_t member : groupMembers[g])
+					{
+						if (IsInterfered(local, member))
+						{
+							interfered = true;
+							break;
+						}
+					}
+					if (!interfered)
+					{
+						group = (int32_t)g;
+					}
+				}
+			}
+			if (group < 0)
+			{
+				group = (int32_t)groupMembers.size();
+				groupMembers.emplace_back();
+				groupShareable.push_back(!_unshareableLocals[local]);
+			}
+			groupMembers[group].push_back(local);
+			_slotGroups[local] = group;
+		}
+		_slotGroupCount = (int32_t)groupMembers.size();
+	}
+}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "../CommonDef.h"
+#include "../metadata/MetadataDef.h"
+#include "../metadata/Opcodes.h"
+
+namespace hybridclr
+{
+namespace transform
+{
+	// assign IL locals to shared stack slot groups. locals whose live ranges never overlap get the same group,
+	// which shrinks the frame and the area InitLocals has to clear.
+	// liveness is computed on IL basic blocks. address-taken and pinned locals always get a group of their own.
+	// the same liveness tells which locals may be read before being written and so actually depend on InitLocals.
+	class LocalVarSlotAllocator
+	{
+	public:
+		LocalVarSlotAllocator(const metadata::MethodBody& body, const std::set<uint32_t>& splitOffsets)
+			: _body(body), _splitOffsets(splitOffsets), _localCount((int32_t)body.localVars.size()), _slotGroupCount(0) { }
+
+		void Allocate();
+
+		int32_t GetSlotGroupCount() const { return _slotGroupCount; }
+
+		int32_t GetSlotGroup(int32_t localIdx) const { return _slotGroups[localIdx]; }
+
+		bool IsZeroInitRequired(int32_t localIdx) const { return _zeroInitLocals[localIdx]; }
+
+	private:
+		typedef std::vector<uint64_t> LocalVarSet;
+
+		struct ILInst
+		{
+			uint32_t offset;
+			const metadata::OpCodeInfo* oc;
+			const byte* operand;
+			int32_t useLocal;
+			int32_t defLocal;
+		};
+
+		struct ILBlock
+		{
+			uint32_t beginOffset;
+			uint32_t endOffset;
+			uint32_t firstInst;
+			uint32_t endInst;
+			std::vector<uint32_t> succs;
+			std::vector<uint32_t> handlers;
+			LocalVarSet gen;
+			LocalVarSet kill;
+			LocalVarSet liveIn;
+			LocalVarSet liveOut;
+		};
+
+		const metadata::MethodBody& _body;
+		const std::set<uint32_t>& _splitOffsets;
+		int32_t _localCount;
+		int32_t _slotGroupCount;
+		std::vector<int32_t> _slotGroups;
+
+		std::vector<ILInst> _insts;
+		std::vector<ILBlock> _blocks;
+		std::vector<bool> _unshareableLocals;
+		std::vector<bool> _interferences;
+		std::vector<bool> _zeroInitLocals;
+
+		void AllocateOwnSlotGroups();
+		bool DecodeInstructions();
+		bool BuildBlocks();
+		int32_t FindBlockIndex(uint32_t offset) const;
+		void ComputeLiveness();
+		void ComputeInterferences();
+		void ComputeZeroInitLocals();
+		void AddInterference(int32_t a, int32_t b);
+		bool IsInterfered(int32_t a, int32_t b) const { return _interferences[a * _localCount + b]; }
+	};
+}
+}
@@ -0,0 +1,359 @@
+#include "LoopArrayAccessAnalyzer.h"
+
+#include <algorithm>
+
+#include "../metadata/MetadataUtil.h"
+
+#include "LocalVarOpcodes.h"
+
+using namespace hybridclr::metadata;
+
+namespace hybridclr
+{
+namespace transform
+{
+
+	static bool IsLdcI4Zero(const OpCodeInfo* oc, const byte* operand)
+	{
+		switch (oc->id)
+		{
+		case OpcodeEnum::LDC_I4_0: return true;
+		case OpcodeEnum::LDC_I4_S: return GetI1(operand) == 0;
+		case OpcodeEnum::LDC_I4: return GetI4LittleEndian(operand) == 0;
+		default: return false;
+		}
+	}
+
+	// instructions that push exactly one value without side effects
+	static bool IsSimplePush(const OpCodeInfo* oc)
+	{
+		switch (oc->id)
+		{
+		case OpcodeEnum::LDLOC_0:
+		case OpcodeEnum::LDLOC_1:
+		case OpcodeEnum::LDLOC_2:
+		case OpcodeEnum::LDLOC_3:
+		case OpcodeEnum::LDLOC_S:
+		case OpcodeEnum::LDLOC:
+		case OpcodeEnum::LDARG_0:
+		case OpcodeEnum::LDARG_1:
+		case OpcodeEnum::LDARG_2:
+		case OpcodeEnum::LDARG_3:
+		case OpcodeEnum::LDARG_S:
+		case OpcodeEnum::LDARG:
+		case OpcodeEnum::LDC_I4_M1:
+		case OpcodeEnum::LDC_I4_0:
+		case OpcodeEnum::LDC_I4_1:
+		case OpcodeEnum::LDC_I4_2:
+		case OpcodeEnum::LDC_I4_3:
+		case OpcodeEnum::LDC_I4_4:
+		case OpcodeEnum::LDC_I4_5:
+		case OpcodeEnum::LDC_I4_6:
+		case OpcodeEnum::LDC_I4_7:
+		case OpcodeEnum::LDC_I4_8:
+		case OpcodeEnum::LDC_I4_S:
+		case OpcodeEnum::LDC_I4:
+		case OpcodeEnum::LDC_I8:
+		case OpcodeEnum::LDC_R4:
+		case OpcodeEnum::LDC_R8:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static bool IsArrayLoad(const OpCodeInfo* oc)
+	{
+		switch (oc->id)
+		{
+		case OpcodeEnum::LDELEMA:
+		case OpcodeEnum::LDELEM_I1:
+		case OpcodeEnum::LDELEM_U1:
+		case OpcodeEnum::LDELEM_I2:
+		case OpcodeEnum::LDELEM_U2:
+		case OpcodeEnum::LDELEM_I4:
+		case OpcodeEnum::LDELEM_U4:
+		case OpcodeEnum::LDELEM_I8:
+		case OpcodeEnum::LDELEM_I:
+		case OpcodeEnum::LDELEM_R4:
+		case OpcodeEnum::LDELEM_R8:
+		case OpcodeEnum::LDELEM_REF:
+		case OpcodeEnum::LDELEM:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// stelem.ref is excluded, it still needs the covariance check
+	static bool IsArrayStore(const OpCodeInfo* oc)
+	{
+		switch (oc->id)
+		{
+		case OpcodeEnum::STELEM_I:
+		case OpcodeEnum::STELEM_I1:
+		case OpcodeEnum::STELEM_I2:
+		case OpcodeEnum::STELEM_I4:
+		case OpcodeEnum::STELEM_I8:
+		case OpcodeEnum::STELEM_R4:
+		case OpcodeEnum::STELEM_R8:
+		case OpcodeEnum::STELEM:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool LoopArrayAccessAnalyzer::DecodeInstructions(std::vector<bool>& addressTakenLocals)
+	{
+		const byte* ilcodeStart = _body.ilcodes;
+		const byte* codeEnd = ilcodeStart + _body.codeSize;
+		const byte* ip = ilcodeStart;
+
+		while (ip < codeEnd)
+		{
+			uint32_t offset = (uint32_t)(ip - ilcodeStart);
+			const OpCodeInfo* oc = DecodeOpCodeInfo(ip, codeEnd);
+			if (!oc)
+			{
+				return false;
+			}
+			int32_t opCodeSize = GetOpCodeSize(ip, oc);
+			const byte* nextIp = ip + opCodeSize;
+			uint32_t nextOffset = (uint32_t)(nextIp - ilcodeStart);
+			_insts.push_back({ offset, oc, ip + 1 });
+
+			switch (oc->inlineType)
+			{
+			case ArgType::BranchTarget:
+			{
+				int32_t brOffset = oc->inlineParam == 1 ? GetI1(ip + 1) : GetI4LittleEndian(ip + 1);
+				uint32_t targetOffset = nextOffset + brOffset;
+				_branches.push_back({ offset, targetOffset });
+				_jumpTargets.insert(targetOffset);
+				break;
+			}
+			case ArgType::Switch:
+			{
+				uint32_t caseNum = GetI4LittleEndian(ip + 1);
+				for (uint32_t caseIdx = 0; caseIdx < caseNum; caseIdx++)
+				{
+					uint32_t targetOffset = nextOffset + GetI4LittleEndian(ip + 5 + caseIdx * 4);
+					_branches.push_back({ offset, targetOffset });
+					_jumpTargets.insert(targetOffset);
+				}
+				break;
+			}
+			default:
+			{
+				int32_t localIdx = GetLdlocaIndex(oc, ip + 1);
+				if (localIdx >= 0 && localIdx < (int32_t)addressTakenLocals.size())
+				{
+					addressTakenLocals[localIdx] = true;
+				}
+				break;
+			}
+			}
+			ip = nextIp;
+		}
+		for (const ExceptionClause& eh : _body.exceptionClauses)
+		{
+			_jumpTargets.insert(eh.handlerOffsets);
+			if (eh.flags == CorILExceptionClauseType::Filter)
+			{
+				_jumpTargets.insert(eh.classTokenOrFilterOffset);
+			}
+		}
+		return ip == codeEnd;
+	}
+
+	size_t LoopArrayAccessAnalyzer::FindInstIndex(uint32_t offset) const
+	{
+		auto it = std::lower_bound(_insts.begin(), _insts.end(), offset, [](const ILInst& inst, uint32_t off) { return inst.offset < off; });
+		return it != _insts.end() && it->offset == offset ? (size_t)(it - _insts.begin()) : _insts.size();
+	}
+
+	bool LoopArrayAccessAnalyzer::IsLoopVariablesSafe(int32_t indexVar, int32_t arrVar, const std::vector<bool>& addressTakenLocals) const
+	{
+		if (indexVar < 0 || arrVar < 0 || indexVar == arrVar
+			|| indexVar >= (int32_t)_body.localVars.size() || arrVar >= (int32_t)_body.localVars.size())
+		{
+			return false;
+		}
+		if (addressTakenLocals[indexVar] || addressTakenLocals[arrVar])
+		{
+			return false;
+		}
+		const Il2CppType* indexType = _body.localVars[indexVar];
+		const Il2CppType* arrType = _body.localVars[arrVar];
+		return indexType->type == IL2CPP_TYPE_I4 && !indexType->byref && arrType->type == IL2CPP_TYPE_SZARRAY && !arrType->byref;
+	}
+
+	bool LoopArrayAccessAnalyzer::IsEnteredOnlyFromHead(uint32_t loopBegin, uint32_t loopEnd, uint32_t entryBranchOffset, uint32_t condOffset) const
+	{
+		for (const BranchInfo& br : _branches)
+		{
+			if (br.targetOffset < loopBegin || br.targetOffset >= loopEnd)
+			{
+				continue;
+			}
+			if (br.srcOffset >= loopBegin && br.srcOffset < loopEnd)
+			{
+				continue;
+			}
+			if (br.srcOffset == entryBranchOffset && br.targetOffset == condOffset)
+			{
+				continue;
+			}
+			return false;
+		}
+		for (const ExceptionClause& eh : _body.exceptionClauses)
+		{
+			bool tryInLoop = eh.tryOffset >= loopBegin && eh.tryOffset + eh.tryLength <= loopEnd;
+			if (eh.handlerOffsets >= loopBegin && eh.handlerOffsets < loopEnd && !tryInLoop)
+			{
+				return false;
+			}
+			if (eh.flags == CorILExceptionClauseType::Filter && eh.classTokenOrFilterOffset >= loopBegin && eh.classTokenOrFilterOffset < loopEnd && !tryInLoop)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void LoopArrayAccessAnalyzer::MarkUncheckedAccesses(size_t bodyBeginIdx, size_t bodyEndIdx, int32_t indexVar, int32_t arrVar)
+	{
+		for (size_t i = bodyBeginIdx; i + 2 < bodyEndIdx; i++)
+		{
+			const ILInst& ldArr = _insts[i];
+			const ILInst& ldIndex = _insts[i + 1];
+			if (GetLdlocIndex(ldArr.oc, ldArr.operand) != arrVar || GetLdlocIndex(ldIndex.oc, ldIndex.operand) != indexVar
+				|| _jumpTargets.find(ldIndex.offset) != _jumpTargets.end())
+			{
+				continue;
+			}
+			size_t accessIdx = i + 2;
+			if (_insts[accessIdx].oc->id == OpcodeEnum::READONLY_ && accessIdx + 1 < bodyEndIdx)
+			{
+				++accessIdx;
+			}
+			const ILInst& access = _insts[accessIdx];
+			if (_jumpTargets.find(access.offset) != _jumpTargets.end())
+			{
+				continue;
+			}
+			if (IsArrayLoad(access.oc))
+			{
+				_uncheckedAccessOffsets.insert(access.offset);
+			}
+			else if (IsSimplePush(access.oc) && accessIdx + 1 < bodyEndIdx)
+			{
+				const ILInst& store = _insts[accessIdx + 1];
+				if (IsArrayStore(store.oc) && _jumpTargets.find(store.offset) == _jumpTargets.end())
+				{
+					_uncheckedAccessOffsets.insert(store.offset);
+				}
+			}
+		}
+	}
+
+	void LoopArrayAccessAnalyzer::AnalyzeLoop(size_t bltIdx, const std::vector<bool>& addressTakenLocals)
+	{
+		// COND: ldloc i; ldloc arr; ldlen; conv.i4; blt BODY
+		if (bltIdx < 4)
+		{
+			return;
+		}
+		size_t condIdx = bltIdx - 4;
+		const ILInst& condLdIndex = _insts[condIdx];
+		const ILInst& condLdArr = _insts[condIdx + 1];
+		if (_insts[condIdx + 2].oc->id != OpcodeEnum::LDLEN || _insts[condIdx + 3].oc->id != OpcodeEnum::CONV_I4)
+		{
+			return;
+		}
+		int32_t indexVar = GetLdlocIndex(condLdIndex.oc, condLdIndex.operand);
+		int32_t arrVar = GetLdlocIndex(condLdArr.oc, condLdArr.operand);
+		if (!IsLoopVariablesSafe(indexVar, arrVar, addressTakenLocals))
+		{
+			return;
+		}
+
+		const ILInst& blt = _insts[bltIdx];
+		uint32_t bltSize = blt.oc->inlineParam + 1;
+		int32_t brOffset = blt.oc->inlineParam == 1 ? GetI1(blt.operand) : GetI4LittleEndian(blt.operand);
+		uint32_t loopBegin = blt.offset + bltSize + brOffset;
+		uint32_t loopEnd = blt.offset + bltSize;
+		if (loopBegin >= condLdIndex.offset)
+		{
+			return;
+		}
+		size_t bodyBeginIdx = FindInstIndex(loopBegin);
+
+		// ldc.i4.0; stloc i; br COND
+		if (bodyBeginIdx < 3 || bodyBeginIdx >= condIdx)
+		{
+			return;
+		}
+		const ILInst& entryBr = _insts[bodyBeginIdx - 1];
+		const ILInst& initStore = _insts[bodyBeginIdx - 2];
+		const ILInst& initValue = _insts[bodyBeginIdx - 3];
+		if (entryBr.oc->id != OpcodeEnum::BR && entryBr.oc->id != OpcodeEnum::BR_S)
+		{
+			return;
+		}
+		int32_t entryBrOffset = entryBr.oc->inlineParam == 1 ? GetI1(entryBr.operand) : GetI4LittleEndian(entryBr.operand);
+		if (loopBegin + entryBrOffset != condLdIndex.offset
+			|| GetStlocIndex(initStore.oc, initStore.operand) != indexVar
+			|| !IsLdcI4Zero(initValue.oc, initValue.operand))
+		{
+			return;
+		}
+
+		// ldloc i; ldc.i4.1; add; stloc i
+		if (condIdx < bodyBeginIdx + 4)
+		{
+			return;
+		}
+		size_t incIdx = condIdx - 4;
+		if (GetLdlocIndex(_insts[incIdx].oc, _insts[incIdx].operand) != indexVar
+			|| _insts[incIdx + 1].oc->id != OpcodeEnum::LDC_I4_1
+			|| _insts[incIdx + 2].oc->id != OpcodeEnum::ADD
+			|| GetStlocIndex(_insts[incIdx + 3].oc, _insts[incIdx + 3].operand) != indexVar)
+		{
+			return;
+		}
+
+		for (size_t i = bodyBeginIdx; i < incIdx; i++)
+		{
+			int32_t storeVar = GetStlocIndex(_insts[i].oc, _insts[i].operand);
+			if (storeVar == indexVar || storeVar == arrVar)
+			{
+				return;
+			}
+		}
+		if (!IsEnteredOnlyFromHead(loopBegin, loopEnd, entryBr.offset, condLdIndex.offset))
+		{
+			return;
+		}
+		MarkUncheckedAccesses(bodyBeginIdx, incIdx, indexVar, arrVar);
+	}
+
+	void LoopArrayAccessAnalyzer::Analyze()
+	{
+		std::vector<bool> addressTakenLocals(_body.localVars.size(), false);
+		if (!DecodeInstructions(addressTakenLocals))
+		{
+			return;
+		}
+		for (size_t i = 0; i < _insts.size(); i++)
+		{
+			OpcodeEnum id = _insts[i].oc->id;
+			if (id == OpcodeEnum::BLT || id == OpcodeEnum::BLT_S)
+			{
+				AnalyzeLoop(i, addressTakenLocals);
+			}
+		}
+	}
+}
+}
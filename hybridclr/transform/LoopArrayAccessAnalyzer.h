@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "../CommonDef.h"
+#include "../metadata/MetadataDef.h"
+#include "../metadata/Opcodes.h"
+
+namespace hybridclr
+{
+namespace transform
+{
+	// find array accesses whose index is proven in range by the enclosing loop, so the transformer can
+	// emit them without null and bounds checks. only the canonical counted loop emitted by Roslyn is recognized:
+	//
+	//     ldc.i4.0; stloc i; br COND;
+	//     BODY: ... ldloc arr; ldloc i; ldelem* ...
+	//     ldloc i; ldc.i4.1; add; stloc i;
+	//     COND: ldloc i; ldloc arr; ldlen; conv.i4; blt BODY
+	//
+	// i must be an int32 local and arr a single-dimension array local, neither may have its address taken,
+	// and neither may be stored to inside the loop except by the increment.
+	// the first COND throws NullReferenceException before BODY runs, so arr is never null in BODY.
+	class LoopArrayAccessAnalyzer
+	{
+	public:
+		typedef Il2CppHashSet<uint32_t, il2cpp::utils::PassThroughHash<uint32_t>> Uin32Set;
+
+		LoopArrayAccessAnalyzer(const metadata::MethodBody& body) : _body(body), _jumpTargets(16), _uncheckedAccessOffsets(16) { }
+
+		void Analyze();
+
+		// il offsets of ldelem/ldelema/stelem instructions that can skip null and bounds checks
+		const Uin32Set& GetUncheckedAccessOffsets() const { return _uncheckedAccessOffsets; }
+	private:
+		struct ILInst
+		{
+			uint32_t offset;
+			const metadata::OpCodeInfo* oc;
+			const byte* operand;
+		};
+
+		struct BranchInfo
+		{
+			uint32_t srcOffset;
+			uint32_t targetOffset;
+		};
+
+		const metadata::MethodBody& _body;
+		std::vector<ILInst> _insts;
+		std::vector<BranchInfo> _branches;
+		Uin32Set _jumpTargets;
+		Uin32Set _uncheckedAccessOffsets;
+
+		bool DecodeInstructions(std::vector<bool>& addressTakenLocals);
+		bool IsLoopVariablesSafe(int32_t indexVar, int32_t arrVar, const std::vector<bool>& addressTakenLocals) const;
+		bool IsEnteredOnlyFromHead(uint32_t loopBegin, uint32_t loopEnd, uint32_t entryBranchOffset, uint32_t condOffset) const;
+		size_t FindInstIndex(uint32_t offset) const;
+		void AnalyzeLoop(size_t bltIdx, const std::vector<bool>& addressTakenLocals);
+		void MarkUncheckedAccesses(size_t bodyBeginIdx, size_t bodyEndIdx, int32_t indexVar, int32_t arrVar);
+	};
+}
+}
@@ -0,0 +1,258 @@
+#include "ObjectEscapeAnalyzer.h"
+
+#include <cstring>
+
+#include "../metadata/MetadataModule.h"
+#include "../metadata/MethodBodyCache.h"
+#include "../metadata/MetadataUtil.h"
+
+#include "LocalVarOpcodes.h"
+
+using namespace hybridclr::metadata;
+
+namespace hybridclr
+{
+namespace transform
+{
+
+	static bool IsConstantPush(const OpCodeInfo* oc)
+	{
+		switch (oc->id)
+		{
+		case OpcodeEnum::LDNULL:
+		case OpcodeEnum::LDC_I4_M1:
+		case OpcodeEnum::LDC_I4_0:
+		case OpcodeEnum::LDC_I4_1:
+		case OpcodeEnum::LDC_I4_2:
+		case OpcodeEnum::LDC_I4_3:
+		case OpcodeEnum::LDC_I4_4:
+		case OpcodeEnum::LDC_I4_5:
+		case OpcodeEnum::LDC_I4_6:
+		case OpcodeEnum::LDC_I4_7:
+		case OpcodeEnum::LDC_I4_8:
+		case OpcodeEnum::LDC_I4_S:
+		case OpcodeEnum::LDC_I4:
+		case OpcodeEnum::LDC_I8:
+		case OpcodeEnum::LDC_R4:
+		case OpcodeEnum::LDC_R8:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// instructions that push exactly one value without side effects
+	static bool IsSimplePush(const OpCodeInfo* oc)
+	{
+		switch (oc->id)
+		{
+		case OpcodeEnum::LDLOC_0:
+		case OpcodeEnum::LDLOC_1:
+		case OpcodeEnum::LDLOC_2:
+		case OpcodeEnum::LDLOC_3:
+		case OpcodeEnum::LDLOC_S:
+		case OpcodeEnum::LDLOC:
+		case OpcodeEnum::LDARG_0:
+		case OpcodeEnum::LDARG_1:
+		case OpcodeEnum::LDARG_2:
+		case OpcodeEnum::LDARG_3:
+		case OpcodeEnum::LDARG_S:
+		case OpcodeEnum::LDARG:
+			return true;
+		default:
+			return IsConstantPush(oc);
+		}
+	}
+
+	// any argument of a .ctor except this
+	static bool IsNonThisLdarg(const OpCodeInfo* oc, const byte* operand)
+	{
+		switch (oc->id)
+		{
+		case OpcodeEnum::LDARG_1:
+		case OpcodeEnum::LDARG_2:
+		case OpcodeEnum::LDARG_3:
+			return true;
+		case OpcodeEnum::LDARG_S: return operand[0] != 0;
+		case OpcodeEnum::LDARG: return GetU2LittleEndian(operand) != 0;
+		default: return false;
+		}
+	}
+
+	bool ObjectEscapeAnalyzer::DecodeInstructions(std::vector<bool>& escapedLocals)
+	{
+		const byte* ilcodeStart = _body.ilcodes;
+		const byte* codeEnd = ilcodeStart + _body.codeSize;
+		const byte* ip = ilcodeStart;
+
+		while (ip < codeEnd)
+		{
+			uint32_t offset = (uint32_t)(ip - ilcodeStart);
+			const OpCodeInfo* oc = DecodeOpCodeInfo(ip, codeEnd);
+			if (!oc)
+			{
+				return false;
+			}
+			int32_t opCodeSize = GetOpCodeSize(ip, oc);
+			_insts.push_back({ offset, oc, ip + 1 });
+
+			int32_t localIdx = GetLdlocaIndex(oc, ip + 1);
+			if (localIdx >= 0 && localIdx < (int32_t)escapedLocals.size())
+			{
+				escapedLocals[localIdx] = true;
+			}
+			ip += opCodeSize;
+		}
+		return ip == codeEnd;
+	}
+
+	void ObjectEscapeAnalyzer::MarkEscapedLocals(std::vector<bool>& escapedLocals) const
+	{
+		for (size_t i = 0; i < _insts.size(); i++)
+		{
+			const ILInst& inst = _insts[i];
+			int32_t localIdx = GetLdlocIndex(inst.oc, inst.operand);
+			if (localIdx < 0 || localIdx >= (int32_t)escapedLocals.size())
+			{
+				continue;
+			}
+			// ldloc x; ldfld
+			if (i + 1 < _insts.size() && _insts[i + 1].oc->id == OpcodeEnum::LDFLD)
+			{
+				continue;
+			}
+			// ldloc x; <push>; stfld. if <push> is itself a ldloc, that local is followed by stfld and escapes.
+			if (i + 2 < _insts.size() && IsSimplePush(_insts[i + 1].oc) && _insts[i + 2].oc->id == OpcodeEnum::STFLD)
+			{
+				continue;
+			}
+			escapedLocals[localIdx] = true;
+		}
+	}
+
+	void ObjectEscapeAnalyzer::Analyze()
+	{
+		std::vector<bool> escapedLocals(_body.localVars.size(), false);
+		if (!DecodeInstructions(escapedLocals))
+		{
+			return;
+		}
+		MarkEscapedLocals(escapedLocals);
+
+		for (size_t i = 0; i < _insts.size(); i++)
+		{
+			const ILInst& newobj = _insts[i];
+			if (newobj.oc->id != OpcodeEnum::NEWOBJ)
+			{
+				continue;
+			}
+			// object initializer: dup; <push>; stfld
+			size_t storeIdx = i + 1;
+			while (storeIdx + 3 < _insts.size() && _insts[storeIdx].oc->id == OpcodeEnum::DUP
+				&& IsSimplePush(_insts[storeIdx + 1].oc) && _insts[storeIdx + 2].oc->id == OpcodeEnum::STFLD)
+			{
+				storeIdx += 3;
+			}
+			if (storeIdx >= _insts.size())
+			{
+				continue;
+			}
+			int32_t localIdx = GetStlocIndex(_insts[storeIdx].oc, _insts[storeIdx].operand);
+			if (localIdx < 0 || localIdx >= (int32_t)escapedLocals.size() || escapedLocals[localIdx] || _body.localVars[localIdx]->byref)
+			{
+				continue;
+			}
+			_stackAllocSites.push_back({ newobj.offset, (uint32_t)GetI4LittleEndian(newobj.operand) });
+		}
+	}
+
+	bool ObjectEscapeAnalyzer::IsTrivialCtor(const MethodInfo* ctor)
+	{
+		if (!ctor->isInterpterImpl)
+		{
+			return false;
+		}
+		Image* image = MetadataModule::GetUnderlyingInterpreterImage(ctor);
+		MethodBody* body = MethodBodyCache::GetMethodBody(image, ctor->token);
+		if (body == nullptr || body->ilcodes == nullptr || !body->exceptionClauses.empty())
+		{
+			return false;
+		}
+
+		const Il2CppGenericContext* genericContext = ctor->is_inflated ? &ctor->genericMethod->context : nullptr;
+		const Il2CppGenericContainer* klassContainer = GetGenericContainerFromIl2CppType(&ctor->klass->byval_arg);
+		Token2RuntimeHandleMap tokenCache(4);
+
+		const byte* ilcodeStart = body->ilcodes;
+		const byte* codeEnd = ilcodeStart + body->codeSize;
+		const byte* ip = ilcodeStart;
+		// ldarg.0 pushed and not consumed yet
+		bool thisPushed = false;
+		const OpCodeInfo* valuePush = nullptr;
+		while (ip < codeEnd)
+		{
+			const OpCodeInfo* oc = DecodeOpCodeInfo(ip, codeEnd);
+			if (!oc)
+			{
+				return false;
+			}
+			const byte* operand = ip + 1;
+			ip += GetOpCodeSize(ip, oc);
+			switch (oc->id)
+			{
+			case OpcodeEnum::NOP:
+			{
+				break;
+			}
+			case OpcodeEnum::LDARG_0:
+			{
+				if (thisPushed)
+				{
+					return false;
+				}
+				thisPushed = true;
+				break;
+			}
+			case OpcodeEnum::CALL:
+			{
+				if (!thisPushed || valuePush)
+				{
+					return false;
+				}
+				const MethodInfo* baseCtor = image->GetMethodInfoFromToken(tokenCache, (uint32_t)GetI4LittleEndian(operand), klassContainer, nullptr, genericContext);
+				if (!baseCtor || baseCtor->klass != il2cpp_defaults.object_class || std::strcmp(baseCtor->name, ".ctor"))
+				{
+					return false;
+				}
+				thisPushed = false;
+				break;
+			}
+			case OpcodeEnum::STFLD:
+			{
+				if (!thisPushed || !valuePush)
+				{
+					return false;
+				}
+				thisPushed = false;
+				valuePush = nullptr;
+				break;
+			}
+			case OpcodeEnum::RET:
+			{
+				return !thisPushed && ip == codeEnd;
+			}
+			default:
+			{
+				if (!thisPushed || valuePush || !(IsNonThisLdarg(oc, operand) || IsConstantPush(oc)))
+				{
+					return false;
+				}
+				valuePush = oc;
+				break;
+			}
+			}
+		}
+		return false;
+	}
+}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include "../CommonDef.h"
+#include "../metadata/MetadataDef.h"
+#include "../metadata/Opcodes.h"
+
+namespace hybridclr
+{
+namespace transform
+{
+	// find newobj sites whose object never escapes the method, so the transformer can place the object in the frame
+	// instead of the gc heap. only the simplest shape is recognized:
+	//
+	//     newobj C::.ctor; [dup; <push>; stfld]*; stloc x
+	//
+	// where every other use of x is `ldloc x; ldfld` or `ldloc x; <push>; stfld`, and x never has its address taken.
+	// x is then the only reference to the object and nothing can outlive the frame through it.
+	// whether C itself is small and its .ctor harmless enough is checked separately by IsTrivialCtor.
+	class ObjectEscapeAnalyzer
+	{
+	public:
+		struct StackAllocSite
+		{
+			uint32_t newobjOffset;
+			uint32_t ctorToken;
+		};
+
+		ObjectEscapeAnalyzer(const metadata::MethodBody& body) : _body(body) { }
+
+		void Analyze();
+
+		const std::vector<StackAllocSite>& GetStackAllocSites() const { return _stackAllocSites; }
+
+		// .ctor only calls System.Object::.ctor and stores arguments or constants into fields of this
+		static bool IsTrivialCtor(const MethodInfo* ctor);
+	private:
+		struct ILInst
+		{
+			uint32_t offset;
+			const metadata::OpCodeInfo* oc;
+			const byte* operand;
+		};
+
+		const metadata::MethodBody& _body;
+		std::vector<ILInst> _insts;
+		std::vector<StackAllocSite> _stackAllocSites;
+
+		bool DecodeInstructions(std::vector<bool>& escapedLocals);
+		void MarkEscapedLocals(std::vector<bool>& escapedLocals) const;
+	};
+}
+}
@@ -0,0 +1,142 @@
+#include "SharedInterpMethodInfoPool.h"
+
+#include <cstring>
+#include <unordered_map>
+
+#include "utils/HashUtils.h"
+
+namespace hybridclr
+{
+namespace transform
+{
+	using interpreter::InterpMethodInfo;
+	using interpreter::InterpExceptionClause;
+	using interpreter::MethodArgDesc;
+
+	struct SharedInterpMethodInfo
+	{
+		const MethodInfo* genericMethodDefinition;
+		InterpMethodInfo imi;
+		uint32_t resolveDataCount;
+	};
+
+	static std::unordered_multimap<size_t, SharedInterpMethodInfo> s_sharedInterpMethodInfos;
+	static uint64_t s_sharedMethodCount = 0;
+	static uint64_t s_savedBytes = 0;
+
+	static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		const uint8_t* p = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash = (hash ^ p[i]) * 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	static size_t ComputeHash(const MethodInfo* genericMethodDefinition, const InterpMethodInfo& imi, uint32_t resolveDataCount, const std::vector<uint32_t>& cacheResolveDataIndexes)
+	{
+		uint64_t hash = HashBytes(14695981039346656037ULL, imi.codes, imi.codeLength);
+		uint32_t begin = 0;
+		for (uint32_t cacheIndex : cacheResolveDataIndexes)
+		{
+			hash = HashBytes(hash, imi.resolveDatas + begin, (cacheIndex - begin) * sizeof(uint64_t));
+			begin = cacheIndex + 1;
+		}
+		hash = HashBytes(hash, imi.resolveDatas + begin, (resolveDataCount - begin) * sizeof(uint64_t));
+		return il2cpp::utils::HashUtils::Combine((size_t)hash, (size_t)genericMethodDefinition);
+	}
+
+	static bool IsSameMemory(const void* a, const void* b, size_t size)
+	{
+		return size == 0 || std::memcmp(a, b, size) == 0;
+	}
+
+	// interpreter threads write the cache slots of the shared buffer without any lock, so they are skipped
+	static bool IsSameResolveDatas(const uint64_t* a, const uint64_t* b, uint32_t resolveDataCount, const std::vector<uint32_t>& cacheResolveDataIndexes)
+	{
+		uint32_t begin = 0;
+		for (uint32_t cacheIndex : cacheResolveDataIndexes)
+		{
+			if (!IsSameMemory(a + begin, b + begin, (cacheIndex - begin) * sizeof(uint64_t)))
+			{
+				return false;
+			}
+			begin = cacheIndex + 1;
+		}
+		return IsSameMemory(a + begin, b + begin, (resolveDataCount - begin) * sizeof(uint64_t));
+	}
+
+	// equal codes embed the same cache slot indexes, so the candidate's list applies to both sides
+	static bool IsSameContent(const SharedInterpMethodInfo& shared, const InterpMethodInfo& b, uint32_t resolveDataCount, const std::vector<uint32_t>& cacheResolveDataIndexes)
+	{
+		const InterpMethodInfo& a = shared.imi;
+		return a.argStackObjectSize == b.argStackObjectSize
+			&& a.retStackObjectSize == b.retStackObjectSize
+			&& a.initLocals == b.initLocals
+			&& a.localStackSize == b.localStackSize
+			&& a.maxStackSize == b.maxStackSize
+			&& a.argCount == b.argCount
+			&& a.codeLength == b.codeLength
+			&& a.localVarBaseOffset == b.localVarBaseOffset
+			&& a.evalStackBaseOffset == b.evalStackBaseOffset
+			&& a.exClauseCount == b.exClauseCount
+			&& a.initLocalsSkippedSize == b.initLocalsSkippedSize
+			&& a.debugInfo == nullptr && b.debugInfo == nullptr
+			&& IsSameMemory(a.codes, b.codes, a.codeLength)
+			&& IsSameResolveDatas(a.resolveDatas, b.resolveDatas, resolveDataCount, cacheResolveDataIndexes)
+			&& IsSameMemory(a.args, b.args, a.argCount * sizeof(MethodArgDesc))
+			&& IsSameMemory(a.exClauses, b.exClauses, a.exClauseCount * sizeof(InterpExceptionClause));
+	}
+
+	static const MethodInfo* GetGenericMethodDefinition(const MethodInfo* method)
+	{
+		return method->is_inflated ? method->genericMethod->methodDefinition : nullptr;
+	}
+
+	bool SharedInterpMethodInfoPool::TryShare(const MethodInfo* method, InterpMethodInfo& candidate, uint32_t resolveDataCount, const std::vector<uint32_t>& cacheResolveDataIndexes)
+	{
+		const MethodInfo* genericMethodDefinition = GetGenericMethodDefinition(method);
+		if (!genericMethodDefinition || candidate.debugInfo)
+		{
+			return false;
+		}
+		size_t hash = ComputeHash(genericMethodDefinition, candidate, resolveDataCount, cacheResolveDataIndexes);
+		auto range = s_sharedInterpMethodInfos.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			const SharedInterpMethodInfo& shared = it->second;
+			if (shared.genericMethodDefinition == genericMethodDefinition && shared.resolveDataCount == resolveDataCount
+				&& IsSameContent(shared, candidate, resolveDataCount, cacheResolveDataIndexes))
+			{
+				candidate.codes = shared.imi.codes;
+				candidate.resolveDatas = shared.imi.resolveDatas;
+				candidate.args = shared.imi.args;
+				candidate.exClauses = shared.imi.exClauses;
+				++s_sharedMethodCount;
+				s_savedBytes += candidate.codeLength + resolveDataCount * sizeof(uint64_t)
+					+ candidate.argCount * sizeof(MethodArgDesc) + candidate.exClauseCount * sizeof(InterpExceptionClause);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void SharedInterpMethodInfoPool::Register(const MethodInfo* method, const InterpMethodInfo& imi, uint32_t resolveDataCount, const std::vector<uint32_t>& cacheResolveDataIndexes)
+	{
+		const MethodInfo* genericMethodDefinition = GetGenericMethodDefinition(method);
+		if (!genericMethodDefinition || imi.debugInfo)
+		{
+			return;
+		}
+		size_t hash = ComputeHash(genericMethodDefinition, imi, resolveDataCount, cacheResolveDataIndexes);
+		s_sharedInterpMethodInfos.insert({ hash, { genericMethodDefinition, imi, resolveDataCount } });
+	}
+
+	void SharedInterpMethodInfoPool::GetStats(uint64_t& sharedMethodCount, uint64_t& savedBytes)
+	{
+		sharedMethodCount = s_sharedMethodCount;
+		savedBytes = s_savedBytes;
+	}
+}
+}
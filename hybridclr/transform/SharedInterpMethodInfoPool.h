@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include "../CommonDef.h"
+#include "../interpreter/InterpreterDefs.h"
+
+namespace hybridclr
+{
+namespace transform
+{
+	// instantiations of one generic method often transform to exactly the same code, resolve data and frame layout,
+	// e.g. a leaf method of List<T> over different reference types. such instantiations share the buffers of the first one
+	// instead of each keeping a copy. callers must hold g_MetadataLock.
+	class SharedInterpMethodInfoPool
+	{
+	public:
+		// candidate is fully built but its buffers are temporary. on a hit they are replaced by the shared ones.
+		// cacheResolveDataIndexes are the ascending isinst/castclass cache slots, which are neither hashed nor compared.
+		static bool TryShare(const MethodInfo* method, interpreter::InterpMethodInfo& candidate, uint32_t resolveDataCount, const std::vector<uint32_t>& cacheResolveDataIndexes);
+
+		// make the committed buffers of method available to later instantiations
+		static void Register(const MethodInfo* method, const interpreter::InterpMethodInfo& imi, uint32_t resolveDataCount, const std::vector<uint32_t>& cacheResolveDataIndexes);
+
+		static void GetStats(uint64_t& sharedMethodCount, uint64_t& savedBytes);
+	};
+}
+}
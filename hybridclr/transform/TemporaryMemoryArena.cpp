@@ -1,5 +1,7 @@
 #include "TemporaryMemoryArena.h"
 
+#include "../MemoryStats.h"
+
 namespace hybridclr
 {
 namespace transform
@@ -8,6 +10,7 @@ namespace transform
 	TemporaryMemoryArena::Block TemporaryMemoryArena::AllocBlock(size_t size)
 	{
 		void* data = HYBRIDCLR_MALLOC(size);
+		MemoryStats::OnAllocate(MemoryCategory::TransformArena, size);
 		return { data, size };
 	}
 
@@ -24,12 +27,14 @@ namespace transform
 		if (_buf)
 		{
 			HYBRIDCLR_FREE(_buf);
+			MemoryStats::OnFree(MemoryCategory::TransformArena, _size);
 			//_buf = nullptr;
 			//_size = _pos = 0;
 		}
 		for (auto& block : _useOuts)
 		{
 			HYBRIDCLR_FREE(block.data);
+			MemoryStats::OnFree(MemoryCategory::TransformArena, block.size);
 		}
 	}
 }
@@ -1,5 +1,7 @@
 #include "TransformContext.h"
 
+#include <algorithm>
+
 #include "metadata/GenericMetadata.h"
 #include "vm/Class.h"
 #include "vm/Exception.h"
@@ -14,6 +16,8 @@
 #include "utils/StringView.h"
 
 #include "../metadata/MethodBodyCache.h"
+#include "SharedInterpMethodInfoPool.h"
+#include "../MemoryStats.h"
 #include "../interpreter/InterpreterUtil.h"
 
 namespace hybridclr
@@ -22,6 +26,9 @@ namespace transform
 {
 	constexpr int32_t MAX_STACK_SIZE = (2 << 16) - 1;
 	constexpr int32_t MAX_VALUE_TYPE_SIZE = (2 << 16) - 1;
+	// in StackObject
+	constexpr int32_t MAX_STACK_ALLOC_OBJECT_SIZE = 16;
+	constexpr int32_t MAX_STACK_ALLOC_OBJECT_TOTAL_SIZE = 128;
 
 	template<typename T>
 	void AllocResolvedData(il2cpp::utils::dynamic_array<uint64_t>& resolvedDatas, int32_t size, int32_t& index, T*& buf)
@@ -797,12 +804,8 @@ namespace transform
 		}
 	}
 
-	interpreter::IRCommon* CreateValueTypeLdfld(TemporaryMemoryArena& pool, int32_t dstIdx, int32_t objIdx, const FieldInfo* fieldInfo)
+	interpreter::IRCommon* CreateValueTypeLdfld(TemporaryMemoryArena& pool, int32_t dstIdx, int32_t objIdx, uint32_t offset, LocationDescInfo desc)
 	{
-		uint32_t offset = GetFieldOffset(fieldInfo);
-
-		const Il2CppType* type = fieldInfo->type;
-		LocationDescInfo desc = ComputLocationDescInfo(type);
 		if (offset <= kMaxShortFieldOffset)
 		{
 			return CreateValueTypeLdfldSmall(pool, dstIdx, objIdx, (uint16_t)offset, desc);
@@ -810,7 +813,12 @@ namespace transform
 		else
 		{
 			return CreateValueTypeLdfldLarge(pool, dstIdx, objIdx, offset, desc);
-        }
+		}
+	}
+
+	interpreter::IRCommon* CreateValueTypeLdfld(TemporaryMemoryArena& pool, int32_t dstIdx, int32_t objIdx, const FieldInfo* fieldInfo)
+	{
+		return CreateValueTypeLdfld(pool, dstIdx, objIdx, GetFieldOffset(fieldInfo), ComputLocationDescInfo(fieldInfo->type));
 	}
 
 	interpreter::IRCommon* CreateStfldSmall(TemporaryMemoryArena& pool, int32_t objIdx, const FieldInfo* fieldInfo, int32_t dataIdx, uint16_t offset, LocationDescInfo desc)
@@ -1498,7 +1506,7 @@ namespace transform
 		actualParamCount(0), ip2bb(nullptr), curbb(nullptr), args(nullptr), locals(nullptr), evalStack(nullptr),
 		evalStackTop(0), evalStackBaseOffset(0), curStackSize(0), maxStackSize(0),
 		nextFlowIdx(0), ipBase(nullptr), ip(nullptr), ipOffset(0), ir2offsetMap(nullptr),
-		prefixFlags(0), shareMethod(nullptr), totalIRSize(0), totalArgSize(0), totalArgLocalSize(0), initLocals(false)
+		prefixFlags(0), shareMethod(nullptr), totalIRSize(0), totalArgSize(0), totalArgLocalSize(0), initLocals(false), initLocalsSkippedSize(0)
 	{
 
 	}
@@ -1625,13 +1633,45 @@ namespace transform
 		ip++;
 	}
 
+	// barrier-free variant with the same IR layout
+	static HiOpcodeEnum GetWriteBarrierFreeOpcode(HiOpcodeEnum op)
+	{
+		switch (op)
+		{
+#if HYBRIDCLR_ARCH_64
+		case HiOpcodeEnum::StfldVarVar_ref: return HiOpcodeEnum::StfldVarVar_i8;
+		case HiOpcodeEnum::StfldLargeVarVar_ref: return HiOpcodeEnum::StfldLargeVarVar_i8;
+		case HiOpcodeEnum::StsfldVarVar_ref: return HiOpcodeEnum::StsfldVarVar_i8;
+		case HiOpcodeEnum::StthreadlocalVarVar_ref: return HiOpcodeEnum::StthreadlocalVarVar_i8;
+		case HiOpcodeEnum::StindVarVar_ref: return HiOpcodeEnum::StindVarVar_i8;
+		case HiOpcodeEnum::StobjVarVar_ref: return HiOpcodeEnum::StobjVarVar_8;
+		case HiOpcodeEnum::SetArrayElementVarVar_ref: return HiOpcodeEnum::SetArrayElementVarVar_i8;
+#else
+		case HiOpcodeEnum::StfldVarVar_ref: return HiOpcodeEnum::StfldVarVar_i4;
+		case HiOpcodeEnum::StfldLargeVarVar_ref: return HiOpcodeEnum::StfldLargeVarVar_i4;
+		case HiOpcodeEnum::StsfldVarVar_ref: return HiOpcodeEnum::StsfldVarVar_i4;
+		case HiOpcodeEnum::StthreadlocalVarVar_ref: return HiOpcodeEnum::StthreadlocalVarVar_i4;
+		case HiOpcodeEnum::StindVarVar_ref: return HiOpcodeEnum::StindVarVar_i4;
+		case HiOpcodeEnum::StobjVarVar_ref: return HiOpcodeEnum::StobjVarVar_4;
+		case HiOpcodeEnum::SetArrayElementVarVar_ref: return HiOpcodeEnum::SetArrayElementVarVar_i4;
+#endif
+		case HiOpcodeEnum::StfldVarVar_WriteBarrier_n_2: return HiOpcodeEnum::StfldVarVar_n_2;
+		case HiOpcodeEnum::StfldVarVar_WriteBarrier_n_4: return HiOpcodeEnum::StfldVarVar_n_4;
+		case HiOpcodeEnum::StfldLargeVarVar_WriteBarrier_n_2: return HiOpcodeEnum::StfldLargeVarVar_n_2;
+		case HiOpcodeEnum::StfldLargeVarVar_WriteBarrier_n_4: return HiOpcodeEnum::StfldLargeVarVar_n_4;
+		case HiOpcodeEnum::StobjVarVar_WriteBarrier_n_4: return HiOpcodeEnum::StobjVarVar_n_4;
+		default: return op;
+		}
+	}
+
 	void TransformContext::Add_stind(HiOpcodeEnum opCode)
 	{
 		IL2CPP_ASSERT(evalStackTop >= 2);
 		InsertMemoryBarrier();
 		ResetPrefixFlags();
+		bool writeBarrierFree = IsStoreWithoutWriteBarrier(evalStack[evalStackTop - 2].locOffset, evalStack[evalStackTop - 1].locOffset);
 		CreateAddIR(ir, StindVarVar_i1);
-		ir->type = opCode;
+		ir->type = writeBarrierFree ? GetWriteBarrierFreeOpcode(opCode) : opCode;
 		ir->dst = evalStack[evalStackTop - 2].locOffset;
 		ir->src = evalStack[evalStackTop - 1].locOffset;
 		PopStackN(2);
@@ -2323,6 +2363,7 @@ namespace transform
 		ir->arr = arr.locOffset;
 		ir->index = index.locOffset;
 		ir->dst = arr.locOffset;
+		TryRemoveArrayAccessCheck(ir);
 
 		PopStackN(2);
 		PushStackByReduceType(resultType);
@@ -2336,16 +2377,283 @@ namespace transform
 		EvalStackVarInfo& index = evalStack[evalStackTop - 2];
 		EvalStackVarInfo& ele = evalStack[evalStackTop - 1];
 
+		bool writeBarrierFree = IsStoreWithoutWriteBarrier(-1, ele.locOffset);
 		CreateAddIR(ir, SetArrayElementVarVar_i1);
-		ir->type = opI4;
+		ir->type = writeBarrierFree ? GetWriteBarrierFreeOpcode(opI4) : opI4;
 		ir->arr = arr.locOffset;
 		ir->index = index.locOffset;
 		ir->ele = ele.locOffset;
+		TryRemoveArrayAccessCheck(ir);
 
 		PopStackN(3);
 		ip++;
 	}
 
+	static HiOpcodeEnum GetUncheckedArrayAccessOpcode(HiOpcodeEnum op)
+	{
+		switch (op)
+		{
+		case HiOpcodeEnum::GetArrayElementAddressAddrVarVar: return HiOpcodeEnum::GetArrayElementAddressUncheckedAddrVarVar;
+		case HiOpcodeEnum::GetArrayElementVarVar_i1: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_i1;
+		case HiOpcodeEnum::GetArrayElementVarVar_u1: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_u1;
+		case HiOpcodeEnum::GetArrayElementVarVar_i2: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_i2;
+		case HiOpcodeEnum::GetArrayElementVarVar_u2: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_u2;
+		case HiOpcodeEnum::GetArrayElementVarVar_i4: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_i4;
+		case HiOpcodeEnum::GetArrayElementVarVar_u4: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_u4;
+		case HiOpcodeEnum::GetArrayElementVarVar_i8: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_i8;
+		case HiOpcodeEnum::GetArrayElementVarVar_u8: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_u8;
+		case HiOpcodeEnum::GetArrayElementVarVar_size_12: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_size_12;
+		case HiOpcodeEnum::GetArrayElementVarVar_size_16: return HiOpcodeEnum::GetArrayElementUncheckedVarVar_size_16;
+		case HiOpcodeEnum::SetArrayElementVarVar_i1: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_i1;
+		case HiOpcodeEnum::SetArrayElementVarVar_u1: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_u1;
+		case HiOpcodeEnum::SetArrayElementVarVar_i2: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_i2;
+		case HiOpcodeEnum::SetArrayElementVarVar_u2: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_u2;
+		case HiOpcodeEnum::SetArrayElementVarVar_i4: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_i4;
+		case HiOpcodeEnum::SetArrayElementVarVar_u4: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_u4;
+		case HiOpcodeEnum::SetArrayElementVarVar_i8: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_i8;
+		case HiOpcodeEnum::SetArrayElementVarVar_u8: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_u8;
+		case HiOpcodeEnum::SetArrayElementVarVar_size_12: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_size_12;
+		case HiOpcodeEnum::SetArrayElementVarVar_size_16: return HiOpcodeEnum::SetArrayElementUncheckedVarVar_size_16;
+		default: return op;
+		}
+	}
+
+	void TransformContext::TryRemoveArrayAccessCheck(interpreter::IRCommon* ir)
+	{
+		if (uncheckedArrayAccessOffsets.find(ipOffset) != uncheckedArrayAccessOffsets.end())
+		{
+			ir->type = GetUncheckedArrayAccessOpcode(ir->type);
+		}
+	}
+
+	// must be called before the store IR is added, while the IRs producing its operands are the last ones.
+	// a store needs no write barrier when the stored value is null, or when the destination is an arg or local
+	// of the interpreter stack (dstAddrOffset was produced by ldarga/ldloca), which the gc scans as a root.
+	// dstAddrOffset is -1 for stores whose destination is never on the stack.
+	bool TransformContext::IsStoreWithoutWriteBarrier(int32_t dstAddrOffset, int32_t valueOffset)
+	{
+		if (!HYBRIDCLR_ENABLE_WRITE_BARRIERS || curbb->insts.empty())
+		{
+			return false;
+		}
+		IRCommon* valueIR = curbb->insts.back();
+		if (valueIR->type == HiOpcodeEnum::LdnullVar)
+		{
+			return ((IRLdnullVar*)valueIR)->dst == valueOffset;
+		}
+		if (dstAddrOffset < 0 || curbb->insts.size() < 2)
+		{
+			return false;
+		}
+		// the value IR must only write its own slot, so the address below it is left intact
+		switch (valueIR->type)
+		{
+		case HiOpcodeEnum::LdlocVarVar:
+			if (((IRLdlocVarVar*)valueIR)->dst != valueOffset)
+			{
+				return false;
+			}
+			break;
+		case HiOpcodeEnum::LdlocVarVarSize:
+			if (((IRLdlocVarVarSize*)valueIR)->dst != valueOffset)
+			{
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+		IRCommon* addrIR = curbb->insts[curbb->insts.size() - 2];
+		return addrIR->type == HiOpcodeEnum::LdlocVarAddress && ((IRLdlocVarAddress*)addrIR)->dst == dstAddrOffset;
+	}
+
+	bool TransformContext::TryFoldValueTypeLocation(bool address, int32_t& srcOffset, uint32_t& offset)
+	{
+		// the eval stack top is either a struct copied from an arg/local (`ldloc s`, `ldloc s; ldfld f`...)
+		// or its address (`ldloca s`, `ldloca s; ldflda f`...). the IRs producing it are dropped and the caller
+		// reads straight from the arg/local instead, so the struct is never copied to the eval stack.
+		int32_t topIdx = GetEvalStackTopOffset();
+		size_t firstIdx = curbb->insts.size();
+		uint32_t accOffset = 0;
+		if (address)
+		{
+			for (; firstIdx > 0; --firstIdx)
+			{
+				IRCommon* ir = curbb->insts[firstIdx - 1];
+				if (ir->type == HiOpcodeEnum::LdfldaVarVar)
+				{
+					IRLdfldaVarVar* irLdflda = (IRLdfldaVarVar*)ir;
+					if (irLdflda->dst != topIdx || irLdflda->obj != topIdx)
+					{
+						return false;
+					}
+					accOffset += irLdflda->offset;
+				}
+				else if (ir->type == HiOpcodeEnum::LdfldaLargeVarVar)
+				{
+					IRLdfldaLargeVarVar* irLdflda = (IRLdfldaLargeVarVar*)ir;
+					if (irLdflda->dst != topIdx || irLdflda->obj != topIdx)
+					{
+						return false;
+					}
+					accOffset += irLdflda->offset;
+				}
+				else
+				{
+					break;
+				}
+			}
+			if (firstIdx == 0 || curbb->insts[firstIdx - 1]->type != HiOpcodeEnum::LdlocVarAddress)
+			{
+				return false;
+			}
+			IRLdlocVarAddress* irLdloca = (IRLdlocVarAddress*)curbb->insts[--firstIdx];
+			if (irLdloca->dst != topIdx)
+			{
+				return false;
+			}
+			srcOffset = irLdloca->src;
+		}
+		else
+		{
+			if (firstIdx == 0)
+			{
+				return false;
+			}
+			IRCommon* ir = curbb->insts[--firstIdx];
+			if (ir->type == HiOpcodeEnum::LdlocVarVar)
+			{
+				IRLdlocVarVar* irLdloc = (IRLdlocVarVar*)ir;
+				if (irLdloc->dst != topIdx)
+				{
+					return false;
+				}
+				srcOffset = irLdloc->src;
+			}
+			else if (ir->type == HiOpcodeEnum::LdlocVarVarSize)
+			{
+				IRLdlocVarVarSize* irLdloc = (IRLdlocVarVarSize*)ir;
+				if (irLdloc->dst != topIdx)
+				{
+					return false;
+				}
+				srcOffset = irLdloc->src;
+			}
+			// a previous fold: every LdfldValueTypeVarVar_* shares the dst/obj/offset layout of _i1, so do the Large ones.
+			else if (ir->type >= HiOpcodeEnum::LdfldValueTypeVarVar_i1 && ir->type <= HiOpcodeEnum::LdfldValueTypeVarVar_n_4)
+			{
+				IRLdfldValueTypeVarVar_i1* irLdfld = (IRLdfldValueTypeVarVar_i1*)ir;
+				if (irLdfld->dst != topIdx)
+				{
+					return false;
+				}
+				srcOffset = irLdfld->obj;
+				accOffset = irLdfld->offset;
+			}
+			else if (ir->type >= HiOpcodeEnum::LdfldValueTypeLargeVarVar_i1 && ir->type <= HiOpcodeEnum::LdfldValueTypeLargeVarVar_n_4)
+			{
+				IRLdfldValueTypeLargeVarVar_i1* irLdfld = (IRLdfldValueTypeLargeVarVar_i1*)ir;
+				if (irLdfld->dst != topIdx)
+				{
+					return false;
+				}
+				srcOffset = irLdfld->obj;
+				accOffset = irLdfld->offset;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		// only args and locals stay put, eval stack slots may overlap the destination
+		if (srcOffset >= evalStackBaseOffset)
+		{
+			return false;
+		}
+		curbb->insts.resize(firstIdx);
+		offset = accOffset;
+		return true;
+	}
+
+	static bool IsStaticallyAssignableTo(const Il2CppType* varType, Il2CppClass* klass)
+	{
+		if (varType->byref)
+		{
+			return false;
+		}
+		Il2CppClass* varKlass = il2cpp::vm::Class::FromIl2CppType(varType);
+		return !IS_CLASS_VALUE_TYPE(varKlass) && il2cpp::vm::Class::IsAssignableFrom(klass, varKlass);
+	}
+
+	bool TransformContext::IsEvalStackTopStaticallyAssignableTo(Il2CppClass* klass)
+	{
+		// only handle sequence like `ldloc/ldarg x; castclass T` in one basic block, where the declared type of x already is T.
+		IRCommon* lastIR = GetLastInstrument();
+		if (lastIR == nullptr || lastIR->type != HiOpcodeEnum::LdlocVarVar)
+		{
+			return false;
+		}
+		IRLdlocVarVar* irLdloc = (IRLdlocVarVar*)lastIR;
+		if (irLdloc->dst != GetEvalStackTopOffset())
+		{
+			return false;
+		}
+		// locals with disjoint live ranges may share a slot, every variable living in the slot must qualify.
+		bool found = false;
+		for (int32_t i = 0; i < actualParamCount; i++)
+		{
+			if (args[i].argLocOffset == irLdloc->src)
+			{
+				if (!IsStaticallyAssignableTo(args[i].type, klass))
+				{
+					return false;
+				}
+				found = true;
+			}
+		}
+		for (size_t i = 0; i < body.localVars.size(); i++)
+		{
+			if (locals[i].locOffset == irLdloc->src)
+			{
+				if (!IsStaticallyAssignableTo(locals[i].type, klass))
+				{
+					return false;
+				}
+				found = true;
+			}
+		}
+		return found;
+	}
+
+	void TransformContext::Add_castclass(Il2CppClass* klass)
+	{
+		if (IsEvalStackTopStaticallyAssignableTo(klass))
+		{
+			return;
+		}
+		CreateAddIR(ir, CastclassCacheVar);
+		ir->obj = GetEvalStackTopOffset();
+		ir->klass = GetOrAddResolveDataIndex(klass);
+		ir->cache = (uint32_t)resolveDatas.size();
+		cacheResolveDataIndexes.push_back(ir->cache);
+		resolveDatas.push_back(0);
+	}
+
+	void TransformContext::Add_isinst(Il2CppClass* klass)
+	{
+		if (IsEvalStackTopStaticallyAssignableTo(klass))
+		{
+			// null stays null, any other value already is an instance of klass.
+			return;
+		}
+		CreateAddIR(ir, IsInstCacheVar);
+		ir->obj = GetEvalStackTopOffset();
+		ir->klass = GetOrAddResolveDataIndex(klass);
+		ir->cache = (uint32_t)resolveDatas.size();
+		cacheResolveDataIndexes.push_back(ir->cache);
+		resolveDatas.push_back(0);
+	}
+
 	static int GetTypeSize(const Il2CppType* type)
 	{
 		if (type->byref)
@@ -2671,6 +2979,18 @@ else \
 		return nullptr;
 	}
 
+	static bool IsStackAllocatableClass(Il2CppClass* klass)
+	{
+		if (IS_CLASS_VALUE_TYPE(klass) || klass->parent != il2cpp_defaults.object_class || klass->is_generic
+			|| (klass->flags & TYPE_ATTRIBUTE_ABSTRACT))
+		{
+			return false;
+		}
+		il2cpp::vm::Class::Init(klass);
+		return !klass->has_finalize
+			&& klass->instance_size <= MAX_STACK_ALLOC_OBJECT_SIZE * sizeof(StackObject);
+	}
+
 	static bool ShouldBeInlined(const MethodInfo* method, int32_t depth)
 	{
 		if (depth >= RuntimeConfig::GetMaxMethodInlineDepth())
@@ -2700,6 +3020,9 @@ else \
 		BasicBlockSpliter bbc(body);
 		bbc.SplitBasicBlocks();
 
+		LoopArrayAccessAnalyzer laa(body);
+		laa.Analyze();
+		uncheckedArrayAccessOffsets = laa.GetUncheckedAccessOffsets();
 
 		splitOffsets = bbc.GetSplitOffsets();
 
@@ -2762,15 +3085,74 @@ else \
 			}
 		}
 
-		totalArgLocalSize = totalArgSize;
+		LocalVarSlotAllocator slotAllocator(body, splitOffsets);
+		slotAllocator.Allocate();
+		std::vector<int32_t> slotGroupSizes(slotAllocator.GetSlotGroupCount(), 0);
+		std::vector<bool> slotGroupZeroInits(slotGroupSizes.size(), false);
 		for (size_t i = 0; i < body.localVars.size(); i++)
 		{
 			LocVarInfo& local = locals[i];
 			local.type = InflateIfNeeded(body.localVars[i], genericContext, true);
 			local.klass = il2cpp::vm::Class::FromIl2CppType(local.type);
 			il2cpp::vm::Class::SetupFields(local.klass);
-			local.locOffset = localVarOffset + totalArgLocalSize;
-			totalArgLocalSize += GetTypeValueStackObjectCount(local.type);
+			int32_t slotGroup = slotAllocator.GetSlotGroup((int32_t)i);
+			slotGroupSizes[slotGroup] = std::max(slotGroupSizes[slotGroup], GetTypeValueStackObjectCount(local.type));
+			if (slotAllocator.IsZeroInitRequired((int32_t)i))
+			{
+				slotGroupZeroInits[slotGroup] = true;
+			}
+		}
+
+		// groups that may be read before being written are laid out first, so InitLocals only has to clear a prefix
+		// of the local area. the rest is always stored before being read and is left as is.
+		totalArgLocalSize = totalArgSize;
+		int32_t zeroInitLocalSize = 0;
+		std::vector<int32_t> slotGroupOffsets(slotGroupSizes.size());
+		for (int32_t pass = 0; pass < 2; pass++)
+		{
+			bool zeroInit = pass == 0;
+			for (size_t i = 0; i < slotGroupSizes.size(); i++)
+			{
+				if (slotGroupZeroInits[i] != zeroInit)
+				{
+					continue;
+				}
+				slotGroupOffsets[i] = localVarOffset + totalArgLocalSize;
+				totalArgLocalSize += slotGroupSizes[i];
+			}
+			if (zeroInit)
+			{
+				zeroInitLocalSize = totalArgLocalSize - totalArgSize;
+			}
+		}
+		for (size_t i = 0; i < body.localVars.size(); i++)
+		{
+			locals[i].locOffset = slotGroupOffsets[slotAllocator.GetSlotGroup((int32_t)i)];
+		}
+
+		Token2RuntimeHandleMap tokenCache(64);
+
+		ObjectEscapeAnalyzer oea(body);
+		oea.Analyze();
+		int32_t totalStackAllocObjectSize = 0;
+		for (const ObjectEscapeAnalyzer::StackAllocSite& site : oea.GetStackAllocSites())
+		{
+			const MethodInfo* ctor = image->GetMethodInfoFromToken(tokenCache, site.ctorToken, klassContainer, methodContainer, genericContext);
+			if (!ctor || !IsStackAllocatableClass(ctor->klass) || !ObjectEscapeAnalyzer::IsTrivialCtor(ctor))
+			{
+				continue;
+			}
+			inlinees.push_back(ctor);
+			int32_t objectSize = (int32_t)((ctor->klass->instance_size + sizeof(StackObject) - 1) / sizeof(StackObject));
+			if (totalStackAllocObjectSize + objectSize > MAX_STACK_ALLOC_OBJECT_TOTAL_SIZE)
+			{
+				break;
+			}
+			// every execution of the site reuses the same storage. the previous object is only referenced by
+			// the local the site stores into, which the new object overwrites.
+			stackAllocObjectStorages.insert({ site.newobjOffset, localVarOffset + totalArgLocalSize });
+			totalArgLocalSize += objectSize;
+			totalStackAllocObjectSize += objectSize;
 		}
 
 		evalStackBaseOffset = localVarOffset + totalArgLocalSize;
@@ -2795,8 +3177,6 @@ else \
 
 		shareMethod = nullptr;
 
-		Token2RuntimeHandleMap tokenCache(64);
-
 		bool inMethodInlining = depth > 0;
 
 		hybridclr::metadata::PDBImage* pdbImage = image->GetPDBImage();
@@ -2823,10 +3203,14 @@ else \
 		}
 
 		initLocals = (body.flags & (uint32_t)CorILMethodFormat::InitLocals) != 0;
-		// init local vars
+		// init local vars. stack allocated objects are cleared by their newobj and never need it.
 		if (initLocals && totalLocalSize > 0)
 		{
-			AddInst(CreateInitLocals(pool, totalLocalSize * sizeof(StackObject), locals[0].locOffset));
+			if (zeroInitLocalSize > 0)
+			{
+				AddInst(CreateInitLocals(pool, zeroInitLocalSize * sizeof(StackObject), localVarOffset + totalArgSize));
+			}
+			initLocalsSkippedSize += (totalLocalSize - zeroInitLocalSize) * sizeof(StackObject);
 		}
 
 		exClauses.resize_initialized(body.exceptionClauses.size());
@@ -4267,7 +4651,20 @@ else \
 				uint32_t token = (uint32_t)GetI4LittleEndian(ip + 1);
 				Il2CppClass* objKlass = image->GetClassFromToken(tokenCache, token, klassContainer, methodContainer, genericContext);
 				IL2CPP_ASSERT(objKlass);
-				if (IS_CLASS_VALUE_TYPE(objKlass))
+				size_t instCount = curbb->insts.size();
+				IRLdlocVarAddress* dstAddr = instCount >= 2 && curbb->insts[instCount - 2]->type == HiOpcodeEnum::LdlocVarAddress ? (IRLdlocVarAddress*)curbb->insts[instCount - 2] : nullptr;
+				IRLdlocVarAddress* srcAddr = instCount >= 2 && curbb->insts[instCount - 1]->type == HiOpcodeEnum::LdlocVarAddress ? (IRLdlocVarAddress*)curbb->insts[instCount - 1] : nullptr;
+				if (IS_CLASS_VALUE_TYPE(objKlass) && dstAddr && srcAddr && dstAddr->dst == dst.locOffset && srcAddr->dst == src.locOffset
+					&& dstAddr->src < evalStackBaseOffset && srcAddr->src < evalStackBaseOffset)
+				{
+					// `ldloca a; ldloca b; cpobj`, a plain copy between frame slots which needs no write barrier
+					int32_t dstOffset = dstAddr->src;
+					int32_t srcOffset = srcAddr->src;
+					RemoveLastInstrument();
+					RemoveLastInstrument();
+					AddInst(CreateAssignVarVar(pool, dstOffset, srcOffset, GetTypeValueSize(objKlass)));
+				}
+				else if (IS_CLASS_VALUE_TYPE(objKlass))
 				{
 					uint32_t size = GetTypeValueSize(objKlass);
 					if (!HYBRIDCLR_ENABLE_WRITE_BARRIERS || !objKlass->has_references)
@@ -4355,106 +4752,115 @@ else \
 				IL2CPP_ASSERT(objKlass);
 				LocationDescInfo desc = ComputLocationDescInfo(&objKlass->byval_arg);
 
-				switch (desc.type)
-				{
-				case LocationDescType::I1:
-				{
-					CreateAddIR(ir, LdindVarVar_i1);
-					ir->dst = ir->src = top.locOffset;
-					break;
-				}
-				case LocationDescType::U1:
-				{
-					CreateAddIR(ir, LdindVarVar_u1);
-					ir->dst = ir->src = top.locOffset;
-					break;
-				}
-				case LocationDescType::I2:
-				{
-					CreateAddIR(ir, LdindVarVar_i2);
-					ir->dst = ir->src = top.locOffset;
-					break;
-				}
-				case LocationDescType::U2:
-				{
-					CreateAddIR(ir, LdindVarVar_u2);
-					ir->dst = ir->src = top.locOffset;
-					break;
-				}
-				case LocationDescType::I4:
-				{
-					CreateAddIR(ir, LdindVarVar_i4);
-					ir->dst = ir->src = top.locOffset;
-					break;
-				}
-				case LocationDescType::I8:
+				int32_t srcOffset;
+				uint32_t baseOffset;
+				if (TryFoldValueTypeLocation(true, srcOffset, baseOffset))
 				{
-					CreateAddIR(ir, LdindVarVar_i8);
-					ir->dst = ir->src = top.locOffset;
-					break;
-				}
-				case LocationDescType::Ref:
-				{
-					CreateAddIR(ir, LdobjVarVar_ref);
-					ir->dst = ir->src = top.locOffset;
-					break;
+					AddInst(CreateValueTypeLdfld(pool, top.locOffset, srcOffset, baseOffset, desc));
 				}
-				case LocationDescType::S:
-				case LocationDescType::StructContainsRef:
+				else
 				{
-					uint32_t size = GetTypeValueSize(objKlass);
-					switch (size)
+					switch (desc.type)
 					{
-					case 1:
+					case LocationDescType::I1:
 					{
-						CreateAddIR(ir, LdobjVarVar_1);
+						CreateAddIR(ir, LdindVarVar_i1);
 						ir->dst = ir->src = top.locOffset;
 						break;
 					}
-					case 2:
+					case LocationDescType::U1:
 					{
-						CreateAddIR(ir, LdobjVarVar_2);
+						CreateAddIR(ir, LdindVarVar_u1);
 						ir->dst = ir->src = top.locOffset;
 						break;
 					}
-					case 4:
+					case LocationDescType::I2:
 					{
-						CreateAddIR(ir, LdobjVarVar_4);
+						CreateAddIR(ir, LdindVarVar_i2);
 						ir->dst = ir->src = top.locOffset;
 						break;
 					}
-					case 8:
+					case LocationDescType::U2:
 					{
-						CreateAddIR(ir, LdobjVarVar_8);
+						CreateAddIR(ir, LdindVarVar_u2);
 						ir->dst = ir->src = top.locOffset;
 						break;
 					}
-					case 12:
+					case LocationDescType::I4:
 					{
-						CreateAddIR(ir, LdobjVarVar_12);
+						CreateAddIR(ir, LdindVarVar_i4);
 						ir->dst = ir->src = top.locOffset;
 						break;
 					}
-					case 16:
+					case LocationDescType::I8:
 					{
-						CreateAddIR(ir, LdobjVarVar_16);
+						CreateAddIR(ir, LdindVarVar_i8);
 						ir->dst = ir->src = top.locOffset;
 						break;
 					}
-					default:
+					case LocationDescType::Ref:
 					{
-						CreateAddIR(ir, LdobjVarVar_n_4);
+						CreateAddIR(ir, LdobjVarVar_ref);
 						ir->dst = ir->src = top.locOffset;
-						ir->size = size;
 						break;
 					}
+					case LocationDescType::S:
+					case LocationDescType::StructContainsRef:
+					{
+						uint32_t size = GetTypeValueSize(objKlass);
+						switch (size)
+						{
+						case 1:
+						{
+							CreateAddIR(ir, LdobjVarVar_1);
+							ir->dst = ir->src = top.locOffset;
+							break;
+						}
+						case 2:
+						{
+							CreateAddIR(ir, LdobjVarVar_2);
+							ir->dst = ir->src = top.locOffset;
+							break;
+						}
+						case 4:
+						{
+							CreateAddIR(ir, LdobjVarVar_4);
+							ir->dst = ir->src = top.locOffset;
+							break;
+						}
+						case 8:
+						{
+							CreateAddIR(ir, LdobjVarVar_8);
+							ir->dst = ir->src = top.locOffset;
+							break;
+						}
+						case 12:
+						{
+							CreateAddIR(ir, LdobjVarVar_12);
+							ir->dst = ir->src = top.locOffset;
+							break;
+						}
+						case 16:
+						{
+							CreateAddIR(ir, LdobjVarVar_16);
+							ir->dst = ir->src = top.locOffset;
+							break;
+						}
+						default:
+						{
+							CreateAddIR(ir, LdobjVarVar_n_4);
+							ir->dst = ir->src = top.locOffset;
+							ir->size = size;
+							break;
+						}
+						}
+						break;
+					}
+					default:
+					{
+						RaiseExecutionEngineException("field");
+					}
 					}
-					break;
-				}
-				default:
-				{
-					RaiseExecutionEngineException("field");
-				}
 				}
 
 				PopStack();
@@ -4540,6 +4946,34 @@ else \
 						ir->ctorFrameBase = GetEvalStackNewTopOffset();
 						maxStackSize = std::max(maxStackSize, curStackSize + ir->argStackObjectNum + 1);
 					}
+					else if (stackAllocObjectStorages.find(ipOffset) != stackAllocObjectStorages.end())
+					{
+						int32_t storage = stackAllocObjectStorages[ipOffset];
+						if (shareMethod->parameters_count == 0)
+						{
+							CreateAddIR(ir, NewClassInterpStackVar_Ctor_0);
+							ir->obj = GetEvalStackNewTopOffset();
+							ir->storage = storage;
+							ir->method = methodDataIndex;
+							PushStackByReduceType(NATIVE_INT_REDUCE_TYPE);
+							ir->ctorFrameBase = GetEvalStackNewTopOffset();
+							maxStackSize = std::max(maxStackSize, curStackSize + 1); // 1 for __this
+						}
+						else
+						{
+							CreateAddIR(ir, NewClassInterpStackVar);
+							ir->obj = GetEvalStackOffset(callArgEvalStackIdxBase);
+							ir->storage = storage;
+							ir->method = methodDataIndex;
+							ir->argBase = ir->obj;
+							ir->argStackObjectNum = curStackSize - ir->argBase;
+							IL2CPP_ASSERT(ir->argStackObjectNum > 0);
+							PopStackN(shareMethod->parameters_count);
+							PushStackByReduceType(NATIVE_INT_REDUCE_TYPE);
+							ir->ctorFrameBase = GetEvalStackNewTopOffset();
+							maxStackSize = std::max(maxStackSize, curStackSize + ir->argStackObjectNum + 1); // 1 for __this
+						}
+					}
 					else
 					{
 						if (shareMethod->parameters_count == 0)
@@ -4613,11 +5047,7 @@ else \
 				{
 					objKlass = il2cpp::vm::Class::GetNullableArgument(objKlass);
 				}
-				uint32_t klassDataIdx = GetOrAddResolveDataIndex(objKlass);
-
-				CreateAddIR(ir, CastclassVar);
-				ir->obj = GetEvalStackTopOffset();
-				ir->klass = klassDataIdx;
+				Add_castclass(objKlass);
 				ip += 5;
 				continue;
 			}
@@ -4632,11 +5062,7 @@ else \
 				{
 					objKlass = il2cpp::vm::Class::GetNullableArgument(objKlass);
 				}
-				uint32_t klassDataIdx = GetOrAddResolveDataIndex(objKlass);
-
-				CreateAddIR(ir, IsInstVar);
-				ir->obj = GetEvalStackTopOffset();
-				ir->klass = klassDataIdx;
+				Add_isinst(objKlass);
 				ip += 5;
 				continue;
 			}
@@ -4707,7 +5133,17 @@ else \
 				// ldfld obj may be obj or or valuetype or ref valuetype....
 				EvalStackVarInfo& obj = evalStack[evalStackTop - 1];
 				uint16_t topIdx = GetEvalStackTopOffset();
-				IRCommon* ir = obj.reduceType != NATIVE_INT_REDUCE_TYPE && IS_CLASS_VALUE_TYPE(fieldInfo->parent) ? CreateValueTypeLdfld(pool, topIdx, topIdx, fieldInfo) : CreateClassLdfld(pool, topIdx, topIdx, fieldInfo);
+				int32_t srcOffset;
+				uint32_t baseOffset;
+				IRCommon* ir;
+				if (IS_CLASS_VALUE_TYPE(fieldInfo->parent) && TryFoldValueTypeLocation(obj.reduceType == NATIVE_INT_REDUCE_TYPE, srcOffset, baseOffset))
+				{
+					ir = CreateValueTypeLdfld(pool, topIdx, srcOffset, baseOffset + GetFieldOffset(fieldInfo), ComputLocationDescInfo(fieldInfo->type));
+				}
+				else
+				{
+					ir = obj.reduceType != NATIVE_INT_REDUCE_TYPE && IS_CLASS_VALUE_TYPE(fieldInfo->parent) ? CreateValueTypeLdfld(pool, topIdx, topIdx, fieldInfo) : CreateClassLdfld(pool, topIdx, topIdx, fieldInfo);
+				}
 				AddInst(ir);
 				PopStack();
 				PushStackByType(fieldInfo->type);
@@ -4757,7 +5193,12 @@ else \
 				FieldInfo* fieldInfo = const_cast<FieldInfo*>(image->GetFieldInfoFromToken(tokenCache, token, klassContainer, methodContainer, genericContext));
 				IL2CPP_ASSERT(fieldInfo);
 
+				bool writeBarrierFree = IsStoreWithoutWriteBarrier(GetEvalStackOffset_2(), GetEvalStackOffset_1());
 				IRCommon* ir = CreateStfld(pool, GetEvalStackOffset_2(), fieldInfo, GetEvalStackOffset_1());
+				if (writeBarrierFree)
+				{
+					ir->type = GetWriteBarrierFreeOpcode(ir->type);
+				}
 				AddInst(ir);
 				PopStackN(2);
 				ip += 5;
@@ -4835,9 +5276,14 @@ else \
 
 				uint32_t klassIndex = GetOrAddResolveDataIndex(fieldInfo->parent);
 				uint16_t dataIdx = GetEvalStackTopOffset();
+				bool writeBarrierFree = IsStoreWithoutWriteBarrier(-1, dataIdx);
 				IRCommon* ir = fieldInfo->offset != THREAD_STATIC_FIELD_OFFSET ?
 					CreateStsfld(pool, fieldInfo, klassIndex, dataIdx)
 					: CreateStthreadlocal(pool, fieldInfo, klassIndex, dataIdx);
+				if (writeBarrierFree)
+				{
+					ir->type = GetWriteBarrierFreeOpcode(ir->type);
+				}
 				AddInst(ir);
 
 				PopStack();
@@ -4856,12 +5302,13 @@ else \
 				uint32_t token = (uint32_t)GetI4LittleEndian(ip + 1);
 
 				Il2CppClass* objKlass = image->GetClassFromToken(tokenCache, token, klassContainer, methodContainer, genericContext);
+				bool writeBarrierFree = IsStoreWithoutWriteBarrier(dst.locOffset, src.locOffset);
 
 				IL2CPP_ASSERT(objKlass);
 				if (IS_CLASS_VALUE_TYPE(objKlass))
 				{
 					uint32_t size = GetTypeValueSize(objKlass);
-					if (!HYBRIDCLR_ENABLE_WRITE_BARRIERS || !objKlass->has_references)
+					if (!HYBRIDCLR_ENABLE_WRITE_BARRIERS || !objKlass->has_references || writeBarrierFree)
 					{
 						switch (size)
 						{
@@ -4928,6 +5375,7 @@ else \
 				else
 				{
 					CreateAddIR(ir, StobjVarVar_ref);
+					ir->type = writeBarrierFree ? GetWriteBarrierFreeOpcode(ir->type) : ir->type;
 					ir->dst = dst.locOffset;
 					ir->src = src.locOffset;
 				}
@@ -5065,6 +5513,7 @@ else \
 					CreateAddIR(ir, GetArrayElementAddressAddrVarVar);
 					ir->arr = ir->addr = arr.locOffset;
 					ir->index = index.locOffset;
+					TryRemoveArrayAccessCheck(ir);
 				}
 				else
 				{
@@ -5299,6 +5748,7 @@ ir->dst = arr.locOffset;
 					RaiseExecutionEngineException("ldelem not support type");
 				}
 				}
+				TryRemoveArrayAccessCheck(curbb->insts.back());
 				PopStackN(2);
 				PushStackByType(eleType);
 
@@ -5327,6 +5777,7 @@ ir->ele = ele.locOffset;
 				IL2CPP_ASSERT(index.reduceType == EvalStackReduceDataType::I4 || index.reduceType == EvalStackReduceDataType::I8);
 				bool isIndexInt32Type = index.reduceType == EvalStackReduceDataType::I4;
 				LocationDescInfo desc = ComputLocationDescInfo(eleType);
+				bool writeBarrierFree = IsStoreWithoutWriteBarrier(-1, ele.locOffset);
 				switch (desc.type)
 				{
 				case LocationDescType::I1: { CI_stele0(i1); break; }
@@ -5381,6 +5832,11 @@ ir->ele = ele.locOffset;
 					RaiseExecutionEngineException("stelem not support type");
 				}
 				}
+				if (writeBarrierFree)
+				{
+					curbb->insts.back()->type = GetWriteBarrierFreeOpcode(curbb->insts.back()->type);
+				}
+				TryRemoveArrayAccessCheck(curbb->insts.back());
 				PopStackN(3);
 
 				ip += 5;
@@ -5404,9 +5860,7 @@ ir->ele = ele.locOffset;
 				}
 				else
 				{
-					CreateAddIR(ir, CastclassVar);
-					ir->obj = GetEvalStackTopOffset();
-					ir->klass = GetOrAddResolveDataIndex(objKlass);
+					Add_castclass(objKlass);
 				}
 
 				ip += 5;
@@ -6163,19 +6617,26 @@ ir->ele = ele.locOffset;
 		}
 	}
 
-	void TransformContext::BuildInterpMethodInfo(interpreter::InterpMethodInfo& result)
+	static void* CopyToMetadataMemory(const void* data, size_t size)
 	{
-		il2cpp::utils::dynamic_array<hybridclr::metadata::ILMapper>* ilMappers;
-		if (ir2offsetMap)
+		if (size == 0)
 		{
-			ilMappers = new il2cpp::utils::dynamic_array<hybridclr::metadata::ILMapper>();
-			ilMappers->reserve(ir2offsetMap->size());
+			return nullptr;
 		}
-		else
+		void* copy = HYBRIDCLR_METADATA_MALLOC(size);
+		std::memcpy(copy, data, size);
+		return copy;
+	}
+
+	void TransformContext::BuildInterpMethodInfo(interpreter::InterpMethodInfo& result)
+	{
+		il2cpp::utils::dynamic_array<hybridclr::metadata::ILMapper> ilMappers;
+		if (ir2offsetMap)
 		{
-			ilMappers = nullptr;
+			ilMappers.reserve(ir2offsetMap->size());
 		}
-		byte* tranCodes = (byte*)HYBRIDCLR_METADATA_MALLOC(totalIRSize);
+		// buffers are built in the pool first, so an instantiation identical to an earlier one can share its copies
+		byte* tranCodes = pool.NewNAny<byte>(totalIRSize);
 
 		uint32_t tranOffset = 0;
 		for (IRBasicBlock* bb : irbbs)
@@ -6183,7 +6644,7 @@ ir->ele = ele.locOffset;
 			//bb->codeOffset = tranOffset;
 			for (IRCommon* ir : bb->insts)
 			{
-				if (ilMappers)
+				if (ir2offsetMap)
 				{
 					auto it = ir2offsetMap->find(ir);
 					if (it != ir2offsetMap->end())
@@ -6191,7 +6652,7 @@ ir->ele = ele.locOffset;
 						hybridclr::metadata::ILMapper ilMapper;
 						ilMapper.irOffset = tranOffset;
 						ilMapper.ilOffset = it->second;
-						ilMappers->push_back(ilMapper);
+						ilMappers.push_back(ilMapper);
 					}
 				}
 				uint32_t irSize = g_instructionSizes[(int)ir->type];
@@ -6209,7 +6670,8 @@ ir->ele = ele.locOffset;
 		MethodArgDesc* argDescs;
 		if (actualParamCount > 0)
 		{
-			argDescs = (MethodArgDesc*)HYBRIDCLR_METADATA_CALLOC(actualParamCount, sizeof(MethodArgDesc));
+			argDescs = pool.NewNAny<MethodArgDesc>(actualParamCount);
+			std::memset(argDescs, 0, actualParamCount * sizeof(MethodArgDesc));
 			for (int32_t i = 0; i < actualParamCount; i++)
 			{
 				const Il2CppType* argType = args[i].type;
@@ -6237,37 +6699,35 @@ ir->ele = ele.locOffset;
 		result.localStackSize = totalArgLocalSize;
 		result.maxStackSize = maxStackSize;
 		result.initLocals = initLocals;
-
-		if (resolveDatas.empty())
-		{
-			result.resolveDatas = nullptr;
-		}
-		else
-		{
-			//result.resolveData = (uint8_t*)HYBRIDCLR_MALLOC(resolveDatas.size() * sizeof(uint8_t));
-			size_t dataSize = resolveDatas.size() * sizeof(uint64_t);
-			uint64_t* data = (uint64_t*)HYBRIDCLR_METADATA_MALLOC(dataSize);
-			std::memcpy(data, resolveDatas.data(), dataSize);
-			result.resolveDatas = data;
-		}
-		if (exClauses.empty())
-		{
-			result.exClauses = nullptr;
-			result.exClauseCount = 0;
-		}
-		else
-		{
-			size_t dataSize = exClauses.size() * sizeof(InterpExceptionClause);
-			InterpExceptionClause* data = (InterpExceptionClause*)HYBRIDCLR_METADATA_MALLOC(dataSize);
-			std::memcpy(data, exClauses.data(), dataSize);
-			result.exClauses = data;
-			result.exClauseCount = (uint32_t)exClauses.size();
-		}
-
-		if (ilMappers)
-		{
-			image->GetPDBImage()->SetMethodDebugInfo(methodInfo, *ilMappers);
-		}
+		result.initLocalsSkippedSize = initLocalsSkippedSize;
+
+		result.resolveDatas = resolveDatas.empty() ? nullptr : resolveDatas.data();
+		result.exClauses = exClauses.empty() ? nullptr : exClauses.data();
+		result.exClauseCount = (uint32_t)exClauses.size();
+		result.debugInfo = ir2offsetMap ? image->GetPDBImage()->CreateMethodDebugInfo(methodInfo, ilMappers) : nullptr;
+
+		// inlinees belong to this method, not to the buffers a shared instantiation reuses
+		std::sort(inlinees.begin(), inlinees.end());
+		inlinees.erase(std::unique(inlinees.begin(), inlinees.end()), inlinees.end());
+		size_t inlineesSize = inlinees.size() * sizeof(const MethodInfo*);
+		result.inlineeCount = (uint32_t)inlinees.size();
+		result.inlinees = (const MethodInfo* const*)CopyToMetadataMemory(inlinees.data(), inlineesSize);
+
+		uint32_t resolveDataCount = (uint32_t)resolveDatas.size();
+		if (SharedInterpMethodInfoPool::TryShare(methodInfo, result, resolveDataCount, cacheResolveDataIndexes))
+		{
+			MemoryStats::OnAllocate(MemoryCategory::InterpMethodInfo, sizeof(interpreter::InterpMethodInfo) + inlineesSize, methodInfo->klass->image);
+			return;
+		}
+		size_t argsSize = actualParamCount * sizeof(MethodArgDesc);
+		size_t resolveDatasSize = resolveDataCount * sizeof(uint64_t);
+		size_t exClausesSize = result.exClauseCount * sizeof(InterpExceptionClause);
+		result.codes = (byte*)CopyToMetadataMemory(tranCodes, totalIRSize);
+		result.args = (MethodArgDesc*)CopyToMetadataMemory(argDescs, argsSize);
+		result.resolveDatas = (uint64_t*)CopyToMetadataMemory(result.resolveDatas, resolveDatasSize);
+		result.exClauses = (const InterpExceptionClause*)CopyToMetadataMemory(result.exClauses, exClausesSize);
+		SharedInterpMethodInfoPool::Register(methodInfo, result, resolveDataCount, cacheResolveDataIndexes);
+		MemoryStats::OnAllocate(MemoryCategory::InterpMethodInfo, sizeof(interpreter::InterpMethodInfo) + totalIRSize + argsSize + resolveDatasSize + exClausesSize + inlineesSize, methodInfo->klass->image);
 	}
 
 	bool TransformContext::TransformSubMethodBody(TransformContext& callingCtx, const MethodInfo* methodInfo, int32_t depth, int32_t localVarOffset)
@@ -6288,7 +6748,11 @@ ir->ele = ele.locOffset;
 		{
 			ctx.TransformBodyImpl(depth, localVarOffset);
 			callingCtx.maxStackSize = std::max(callingCtx.maxStackSize, ctx.maxStackSize);
+			callingCtx.initLocalsSkippedSize += ctx.initLocalsSkippedSize;
 			callingCtx.curbb->insts.insert(callingCtx.curbb->insts.end(), ctx.curbb->insts.begin(), ctx.curbb->insts.end());
+			callingCtx.inlinees.push_back(methodInfo);
+			callingCtx.inlinees.insert(callingCtx.inlinees.end(), ctx.inlinees.begin(), ctx.inlinees.end());
+			callingCtx.cacheResolveDataIndexes.insert(callingCtx.cacheResolveDataIndexes.end(), ctx.cacheResolveDataIndexes.begin(), ctx.cacheResolveDataIndexes.end());
 			return true;
 		}
 		catch (Il2CppExceptionWrapper&)
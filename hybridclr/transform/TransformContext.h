@@ -16,6 +16,9 @@
 #include "../interpreter/InterpreterModule.h"
 
 #include "Transform.h"
+#include "LoopArrayAccessAnalyzer.h"
+#include "LocalVarSlotAllocator.h"
+#include "ObjectEscapeAnalyzer.h"
 
 namespace hybridclr
 {
@@ -126,6 +129,9 @@ namespace transform
 		int32_t actualParamCount;
 
 		std::set<uint32_t> splitOffsets;
+		LoopArrayAccessAnalyzer::Uin32Set uncheckedArrayAccessOffsets;
+		// il offset of newobj => frame offset of the storage its object is placed in
+		Il2CppHashMap<uint32_t, int32_t, il2cpp::utils::PassThroughHash<uint32_t>> stackAllocObjectStorages;
 		IRBasicBlock** ip2bb;
 		IRBasicBlock* curbb;
 
@@ -142,6 +148,8 @@ namespace transform
 		Il2CppHashMap<const void*, uint32_t, il2cpp::utils::PassThroughHash<const void*>> ptr2DataIdxs;
 		std::vector<int32_t*> relocationOffsets;
 		std::vector<std::pair<int32_t, int32_t>> switchOffsetsInResolveData;
+		// ascending indexes of the isinst/castclass cache slots in resolveDatas, inlined callees included
+		std::vector<uint32_t> cacheResolveDataIndexes;
 		std::vector<FlowInfo*> pendingFlows;
 		int32_t nextFlowIdx;
 
@@ -161,6 +169,10 @@ namespace transform
 		int32_t totalArgSize;
 		int32_t totalArgLocalSize;
 		bool initLocals;
+		// bytes of locals InitLocals doesn't clear because they are always written first, inlined callees included
+		uint32_t initLocalsSkippedSize;
+		// methods whose body was copied into this code, see InterpMethodInfo::inlinees
+		std::vector<const MethodInfo*> inlinees;
 
 	public:
 
@@ -320,6 +332,14 @@ namespace transform
 
 		void Add_ldelem(EvalStackReduceDataType resultType, HiOpcodeEnum opI4);
 		void Add_stelem(HiOpcodeEnum opI4);
+		void TryRemoveArrayAccessCheck(interpreter::IRCommon* ir);
+
+		bool IsStoreWithoutWriteBarrier(int32_t dstAddrOffset, int32_t valueOffset);
+		bool TryFoldValueTypeLocation(bool address, int32_t& srcOffset, uint32_t& offset);
+
+		bool IsEvalStackTopStaticallyAssignableTo(Il2CppClass* klass);
+		void Add_castclass(Il2CppClass* klass);
+		void Add_isinst(Il2CppClass* klass);
 
 		bool FindFirstLeaveHandlerIndex(const std::vector<ExceptionClause>& exceptionClauses, uint32_t leaveOffset, uint32_t targetOffset, uint16_t& index);
 